@@ -904,7 +904,7 @@ static lv_action_res_t lv_app_win_open_anim_create(lv_app_inst_t * app)
      * Independently other parts on  the screen might be changed
      * but they will be soon covered by the window after the animations*/
     lv_inv_area(NULL);
-    lv_inv_area(&cords);
+    lv_obj_inv_area(app->win, &cords);
     
 #endif /* LV_APP_ANIM_WIN != 0*/
 
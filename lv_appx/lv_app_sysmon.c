@@ -13,6 +13,7 @@
 #include "misc/os/ptask.h"
 #include "misc/os/idle.h"
 #include "lvgl/lv_objx/lv_chart.h"
+#include "lvgl/lv_obj/lv_mpool.h"
 #include "lvgl/lv_app/lv_app_util/lv_app_notice.h"
 #include "hal/systick/systick.h"
 
@@ -372,6 +373,14 @@ static void lv_app_sysmon_refr(void)
     sprintf(buf_long, "%s%c%s MEMORY: N/A%c", buf_long, TXT_RECOLOR_CMD, MEM_LABEL_COLOR, TXT_RECOLOR_CMD);
     sprintf(buf_short, "%sMem: N/A\nFrag: N/A", buf_short);
 #endif
+
+#if LV_MPOOL_BLOCK_NUM != 0
+    lv_mpool_stat_t pool_stat;
+    lv_mpool_get_stat(&pool_stat);
+    sprintf(buf_long, "%s\nPool: %d bytes\nBlocks: %d used, %d free\nLarge: %d",
+                  buf_long, (int)pool_stat.size, pool_stat.block_used, pool_stat.block_free, pool_stat.large_num);
+#endif
+
     lv_app_inst_t * app;
     app = lv_app_get_next(NULL, &my_app_dsc);
     while(app != NULL) {
@@ -21,6 +21,21 @@
 /* Buffered rendering: >= LV_DOWNSCALE * LV_HOR_RES or 0 to disable buffering*/
 #define LV_VDB_SIZE        (LV_HOR_RES * 30)
 
+/* Use two Virtual Display buffers (VDB): render into one while the other is flushed.
+ * 'disp_map()' has to start the flush (e.g. with DMA) and return immediately.
+ * Call 'lv_vdb_flush_ready()' when the flush is ready*/
+#define LV_VDB_DOUBLE       0
+
+/* With antialiasing downscale the VDB into a separate buffer (LV_VDB_SIZE / 4).
+ * The next part can be rendered into the VDB while this buffer is flushed.
+ * 'disp_map()' has to work like in LV_VDB_DOUBLE mode*/
+#define LV_VDB_OUT_BUF      0
+
+/* Simulated asynchronous display driver to try the modes above on a PC (POSIX threads).
+ * Call 'lv_vdb_sim_init()' once and 'lv_vdb_sim_map()' from 'disp_map()'*/
+#define LV_VDB_SIM          0
+#define LV_VDB_SIM_DELAY    1000  /*Default time of a transfer in microseconds*/
+
 /* Enable antialaiassing
  * If enabled everything will half-sized
  * Use LV_DOWNSCALE to compensate
@@ -30,8 +45,56 @@
 /*Set the downscaling value*/
 #define LV_DOWNSCALE        (1 << LV_ANTIALIAS)
 
+/* Anti-alias the edges of the rounded corners and the lines without downscaling.
+ * Only with LV_ANTIALIAS 0. For smooth letters enable FONT_ANTIALIAS in misc_conf.h*/
+#define LV_EDGE_AA          0
+
+/* Cache the decoded letters as 8 bit alpha masks to draw them faster into the VDB.
+ * The least recently used letters are dropped if the cache is full*/
+#define LV_GCACHE_SIZE      0             /*Memory for the glyph cache in bytes, e.g. (8 * 1024) (0: disable)*/
+
+/* Cache the blurred corners of the shadows to blend them row by row.
+ * The least recently used shadows are dropped if the cache is full*/
+#define LV_SCACHE_SIZE      0             /*Memory for the shadow cache in bytes, e.g. (4 * 1024) (0: disable)*/
+
+/* Cache the rows of the rounded corners (body and border) to draw them as spans.
+ * The least recently used corners are dropped if the cache is full*/
+#define LV_CCACHE_SIZE      0             /*Memory for the corner cache in bytes, e.g. (2 * 1024) (0: disable)*/
+
+/* Cache the colors of the gradients (one per row or column) to fill the rectangles in one pass.
+ * The least recently used gradients are dropped if the cache is full*/
+#define LV_GRAD_CACHE_SIZE  0             /*Memory for the gradient cache in bytes, e.g. (1 * 1024) (0: disable)*/
+
+/* Dither the gradients with an ordered (4x4) pattern to avoid the color bands.
+ * Only with COLOR_DEPTH 16 and LV_VDB_SIZE != 0*/
+#define LV_GRAD_DITHER      0
+
+/* Record the drawings of the design functions once and replay them in every VDB part
+ * if an area doesn't fit into the VDB. Only with LV_VDB_SIZE != 0*/
+#define LV_DLIST_SIZE       0     /*Memory for the display list in bytes, e.g. (4 * 1024) (0: disable)*/
+
 #define LV_REFR_PERIOD      40    /*Screen refresh period in milliseconds*/
-#define LV_INV_FIFO_SIZE    32    /*The average number of objects on a screen */
+#define LV_REFR_FRAME_SYNC  0     /*1: Process the input and refresh the screen in one task per frame (see 'lv_refr_vsync')*/
+
+/* Render the bands of the large areas from the display list on more threads (POSIX threads).
+ * Every thread has an own LV_VDB_SIZE buffer. Needs LV_DLIST_SIZE != 0 and DISP_HW_ACC 0.
+ * With LV_PROF the statistics of the drawing primitives are not exact*/
+#define LV_REFR_THREAD_NUM  0     /*Number of rendering threads with the refresh task (0, 1: disable)*/
+#define LV_REFR_TILE_H      0     /*Max. height of a band in multi-threaded mode (0: as many rows as fit into the VDB)*/
+
+#define LV_INV_FIFO_SIZE    32    /*Max. number of saved invalid areas. Above it the closest areas are joined*/
+#define LV_REFR_OCCL_NUM    0     /*Max. number of opaque children per object to skip the children under them (0: disable)*/
+
+/* Render profiler: measure the design functions, the draw primitives and the flushing.
+ * Get the results with 'lv_prof_get_frame()' or 'lv_prof_dump()'*/
+#define LV_PROF             0
+#define LV_PROF_FRAME_NUM   8     /*Number of recent frames to keep*/
+#define LV_PROF_OBJ_NUM     8     /*Number of the slowest objects to keep per frame*/
+
+/* Scene benchmark: draw typical scenes without a GUI application and print their refresh time.
+ * Run it with 'lv_bench_run()'*/
+#define LV_BENCH            0
+#define LV_BENCH_FRAME_NUM  10    /*Number of refreshes per scene*/
 
 /*=================
    Misc. setting
@@ -43,10 +106,17 @@
 #define LV_DISPI_DRAG_THROW       20                    /*Drag throw slow-down in [%]. Greater value means faster slow-down */
 #define LV_DISPI_LONG_PRESS_TIME        400             /*Long press time in milliseconds*/
 #define LV_DISPI_LONG_PRESS_REP_TIME    100             /*Repeated trigger period in long press [ms] */
+#define LV_DISPI_HIT_GRID         0                     /*Index the clickable objects in NxN cells to find the pressed object faster (0: disable)*/
+#define LV_DISPI_QUEUE_SIZE       0                     /*Size of the sample queues of the input devices. Push the samples with 'lv_dispi_push' (0: disable)*/
 
 /*lv_obj (base object) settings*/
 #define LV_OBJ_FREE_NUM          1           /*Enable the free number attribute*/
 #define LV_OBJ_FREE_P            1           /*Enable the free pointer attribute*/
+#define LV_OBJ_LAYER             0           /*Enable to cache the rendered objects in layers (see 'lv_obj_set_layer')*/
+#define LV_OBJ_MOVE_COPY         0           /*Enable to copy the drawn pixels on scrolling instead of redrawing them (see 'lv_refr_set_copy_cb')*/
+#define LV_OBJ_STYLE_RES         0           /*Save the inherited style of the objects with NULL style to find it faster (+1 pointer per object)*/
+#define LV_OBJ_STYLE_INDEX       0           /*Index the objects by their style to notify only the users in 'lv_style_refr_objs' (+2 pointers per object)*/
+#define LV_MPOOL_BLOCK_NUM       0           /*Allocate the ext. data of the objects from pools of this many fixed size blocks (0: disable)*/
 
 /*Others*/
 #define LV_COLOR_TRANSP     COLOR_LIME
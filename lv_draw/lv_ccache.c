@@ -0,0 +1,475 @@
+/**
+ * @file lv_ccache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_ccache.h"
+
+#if LV_CCACHE_SIZE != 0
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "misc/gfx/circ.h"
+#include "misc/mem/dyn_mem.h"
+#include "misc/mem/linked_list.h"
+#include "../lv_obj/lv_tpool.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    lv_ccache_corner_t corner;
+    uint8_t * data;             /*The memory of the rows*/
+}lv_ccache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static const lv_ccache_corner_t * lv_ccache_temp(cord_t radius, cord_t bwidth);
+static void lv_ccache_calc(lv_ccache_corner_t * corner, uint8_t * data);
+#if LV_EDGE_AA == 0
+static void lv_ccache_add_span(lv_ccache_row_t * row, cord_t x1, cord_t x2);
+#else
+static void lv_ccache_calc_aa_row(lv_ccache_row_t * row, uint8_t * cov_a, cord_t dy, cord_t r_out, cord_t r_in);
+static cord_t lv_ccache_aa_span(int32_t d2, cord_t dy);
+static uint32_t lv_ccache_aa_sqrt(uint32_t x);
+#endif
+static uint32_t lv_ccache_data_size(cord_t radius);
+static void lv_ccache_rem(lv_ccache_entry_t * entry);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static ll_dsc_t lru_ll;      /*The cached corners. The head is the most recently used*/
+static uint32_t cache_size;
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
+static uint16_t corner_num;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the corner cache
+ */
+void lv_ccache_init(void)
+{
+    ll_init(&lru_ll, sizeof(lv_ccache_entry_t));
+    cache_size = 0;
+    corner_num = 0;
+    lv_ccache_reset_stat();
+}
+
+/**
+ * Get a corner. Calculate it if not cached yet.
+ * The least recently used corners are dropped to keep the memory under LV_CCACHE_SIZE.
+ * @param radius radius of the rectangle (already corrected with its size)
+ * @param bwidth border width from the style or 0 to get the corner of the body
+ * @return pointer to the corner or NULL if there is no enough memory.
+ *         Give it back with 'lv_ccache_release' when the corner is drawn.
+ */
+const lv_ccache_corner_t * lv_ccache_get(cord_t radius, cord_t bwidth)
+{
+    lv_ccache_entry_t * entry;
+    LL_READ(lru_ll, entry) {
+        if(entry->corner.radius == radius && entry->corner.bwidth == bwidth) break;
+    }
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    /* While the bands are rendered in parallel only read the cache.
+     * (The corners are added before in 'lv_draw_rect_prepare')*/
+    if(lv_tpool_busy() != false) {
+        if(entry != NULL) return &entry->corner;
+        return lv_ccache_temp(radius, bwidth);
+    }
+#endif
+
+    if(entry != NULL) {
+        hit_cnt ++;
+        /*Move to the head to be the most recently used*/
+        if(ll_get_head(&lru_ll) != entry) ll_chg_list(&lru_ll, &lru_ll, entry);
+        return &entry->corner;
+    }
+
+    miss_cnt ++;
+
+    uint32_t data_size = lv_ccache_data_size(radius);
+    uint32_t size = data_size + sizeof(lv_ccache_entry_t);
+
+    /*Too large to cache*/
+    if(size > LV_CCACHE_SIZE) return lv_ccache_temp(radius, bwidth);
+
+    /*Drop the least recently used corners to free enough space*/
+    while(cache_size + size > LV_CCACHE_SIZE) {
+        lv_ccache_rem(ll_get_tail(&lru_ll));
+    }
+
+    uint8_t * data = dm_alloc(data_size);
+    if(data == NULL) return NULL;
+
+    entry = ll_ins_head(&lru_ll);
+    if(entry == NULL) {
+        dm_free(data);
+        return NULL;
+    }
+
+    entry->data = data;
+    entry->corner.radius = radius;
+    entry->corner.bwidth = bwidth;
+    entry->corner.temp = 0;
+    lv_ccache_calc(&entry->corner, data);
+
+    cache_size += size;
+    corner_num ++;
+
+    return &entry->corner;
+}
+
+/**
+ * Give back a corner got with 'lv_ccache_get'. Free it if it was too large to cache.
+ * @param corner pointer to a corner
+ */
+void lv_ccache_release(const lv_ccache_corner_t * corner)
+{
+    if(corner->temp == 0) return;
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    bool busy = lv_tpool_busy();
+    if(busy != false) lv_tpool_lock();
+    dm_free(corner);
+    if(busy != false) lv_tpool_unlock();
+#else
+    dm_free(corner);
+#endif
+}
+
+/**
+ * Remove all corners from the cache
+ */
+void lv_ccache_clear(void)
+{
+    lv_ccache_entry_t * entry = ll_get_tail(&lru_ll);
+    while(entry != NULL) {
+        lv_ccache_rem(entry);
+        entry = ll_get_tail(&lru_ll);
+    }
+}
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_ccache_stat_t' variable to store the result
+ */
+void lv_ccache_get_stat(lv_ccache_stat_t * stat)
+{
+    stat->hit = hit_cnt;
+    stat->miss = miss_cnt;
+    stat->size = cache_size;
+    stat->corner_num = corner_num;
+}
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_ccache_reset_stat(void)
+{
+    hit_cnt = 0;
+    miss_cnt = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Calculate a corner without adding it to the cache
+ * @param radius radius of the rectangle
+ * @param bwidth border width or 0 for the body
+ * @return pointer to the corner (free it with 'lv_ccache_release') or NULL if there is no enough memory
+ */
+static const lv_ccache_corner_t * lv_ccache_temp(cord_t radius, cord_t bwidth)
+{
+    uint32_t size = sizeof(lv_ccache_corner_t) + lv_ccache_data_size(radius);
+    lv_ccache_corner_t * corner;
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    bool busy = lv_tpool_busy();
+    if(busy != false) lv_tpool_lock();
+    corner = dm_alloc(size);
+    if(busy != false) lv_tpool_unlock();
+#else
+    corner = dm_alloc(size);
+#endif
+    if(corner == NULL) return NULL;
+
+    corner->radius = radius;
+    corner->bwidth = bwidth;
+    corner->temp = 1;
+    lv_ccache_calc(corner, (uint8_t *) corner + sizeof(lv_ccache_corner_t));
+
+    return corner;
+}
+
+/**
+ * Calculate the rows of a corner the same way as the corner drawing functions of 'lv_draw.c'
+ * @param corner pointer to a corner with initialized 'radius' and 'bwidth'
+ * @param data memory for the rows ('lv_ccache_data_size' bytes)
+ */
+static void lv_ccache_calc(lv_ccache_corner_t * corner, uint8_t * data)
+{
+    cord_t radius = corner->radius;
+    uint16_t row_num = radius + 1;
+    lv_ccache_row_t * row_a = (lv_ccache_row_t *) data;
+    cord_t dy;
+
+    corner->row_a = row_a;
+
+#if LV_EDGE_AA == 0
+    /*Start with empty rows*/
+    for(dy = 0; dy < row_num; dy++) {
+        row_a[dy].start = row_num;
+        row_a[dy].end = -1;
+    }
+
+    point_t cir_out;
+    cord_t tmp_out;
+    circ_init(&cir_out, &tmp_out, radius);
+
+    if(corner->bwidth == 0) {
+        /*Fill the rows until the circle*/
+        while(circ_cont(&cir_out)) {
+            lv_ccache_add_span(&row_a[CIRC_OCT1_Y(cir_out)], 0, CIRC_OCT1_X(cir_out));
+            lv_ccache_add_span(&row_a[CIRC_OCT2_Y(cir_out)], 0, CIRC_OCT2_X(cir_out));
+            circ_next(&cir_out, &tmp_out);
+        }
+
+        /*The row of the center is drawn with the middle of the body*/
+        row_a[0].start = 1;
+        row_a[0].end = 0;
+    } else {
+        /*0 px border width drawn as 1 px, so decrement the bwidth*/
+        cord_t radius_in = radius - (corner->bwidth - 1);
+        if(radius_in < 0) radius_in = 0;
+
+        point_t cir_in;
+        cord_t tmp_in;
+        circ_init(&cir_in, &tmp_in, radius_in);
+
+        cord_t act_w1;
+        cord_t act_w2;
+        while(cir_out.y <= cir_out.x) {
+            /*Calculate the actual width to avoid overwriting pixels*/
+            if(cir_in.y < cir_in.x) {
+                act_w1 = cir_out.x - cir_in.x;
+                act_w2 = act_w1;
+            } else {
+                act_w1 = cir_out.x - cir_out.y;
+                act_w2 = act_w1 - 1;
+            }
+
+            /*The horizontal part of the octet 1 and the vertical part of the octet 2*/
+            lv_ccache_add_span(&row_a[CIRC_OCT1_Y(cir_out)], CIRC_OCT1_X(cir_out) - act_w2, CIRC_OCT1_X(cir_out));
+            for(dy = CIRC_OCT2_Y(cir_out) - act_w1; dy <= CIRC_OCT2_Y(cir_out); dy++) {
+                lv_ccache_add_span(&row_a[dy], CIRC_OCT2_X(cir_out), CIRC_OCT2_X(cir_out));
+            }
+
+            circ_next(&cir_out, &tmp_out);
+
+            /*The internal circle will be ready faster so check it!*/
+            if(cir_in.y < cir_in.x) {
+                circ_next(&cir_in, &tmp_in);
+            }
+        }
+    }
+
+    /*Without anti-aliasing all the pixels are fully covered*/
+    for(dy = 0; dy < row_num; dy++) {
+        row_a[dy].full_start = row_a[dy].start;
+        row_a[dy].full_end = row_a[dy].end;
+    }
+#else
+    uint8_t * cov_a = data + row_num * sizeof(lv_ccache_row_t);
+    corner->cov_a = cov_a;
+    memset(cov_a, 0, row_num * row_num);
+
+    if(corner->bwidth == 0) {
+        /*The row of the center is drawn with the middle of the body*/
+        row_a[0].start = 1;
+        row_a[0].full_start = 1;
+        row_a[0].full_end = 0;
+        row_a[0].end = 0;
+        for(dy = 1; dy < row_num; dy++) {
+            lv_ccache_calc_aa_row(&row_a[dy], &cov_a[dy * row_num], dy, radius, 0);
+        }
+    } else {
+        /*0 px border width drawn as 1 px, so decrement the bwidth*/
+        cord_t radius_in = radius - (corner->bwidth - 1);
+        for(dy = 0; dy < row_num; dy++) {
+            lv_ccache_calc_aa_row(&row_a[dy], &cov_a[dy * row_num], dy, radius, radius_in);
+        }
+    }
+#endif
+}
+
+#if LV_EDGE_AA == 0
+/**
+ * Add pixels to a row
+ * @param row pointer to a row
+ * @param x1 the first pixel to add
+ * @param x2 the last pixel to add (< x1: nothing is added)
+ */
+static void lv_ccache_add_span(lv_ccache_row_t * row, cord_t x1, cord_t x2)
+{
+    if(x2 < x1) return;
+
+    if(row->start > x1) row->start = x1;
+    if(row->end < x2) row->end = x2;
+}
+#else
+/**
+ * Calculate a row of an anti-aliased quarter circle or quarter ring
+ * (the same way as 'lv_draw_aa_corner_row' draws it)
+ * @param row pointer to the row to set
+ * @param cov_a store the coverage of the pixels here ('r_out + 1' elements)
+ * @param dy distance of the row from the center
+ * @param r_out radius of the outer edge
+ * @param r_in radius of the inner edge (<= 0 for a full quarter circle)
+ */
+static void lv_ccache_calc_aa_row(lv_ccache_row_t * row, uint8_t * cov_a, cord_t dy, cord_t r_out, cord_t r_in)
+{
+    cord_t dx = 0;
+    cord_t full_end;
+    uint32_t d16;       /*Distance of a pixel from the center * 16*/
+    int32_t cov_out;    /*Coverage of a pixel by the outer circle (0..16)*/
+    int32_t cov_in;     /*Coverage of a pixel by the outside of the inner circle (0..16)*/
+
+    /*Skip the pixels which are fully inside the inner circle*/
+    if(r_in > 0) dx = lv_ccache_aa_span(2 * r_in - 2, dy) + 1;
+
+    row->start = dx;
+    row->full_start = r_out + 1;
+    row->full_end = r_out;
+
+    while(dx <= r_out) {
+        d16 = lv_ccache_aa_sqrt((uint32_t)(dx * dx + dy * dy) << 8);
+        cov_out = (int32_t)r_out * 16 + 16 - (int32_t)d16;
+        if(cov_out <= 0) break;                 /*Out of the outer circle*/
+        if(cov_out > 16) cov_out = 16;
+
+        cov_in = 16;
+        if(r_in > 0) {
+            cov_in = (int32_t)d16 - ((int32_t)r_in * 16 - 16);
+            if(cov_in < 0) cov_in = 0;
+            if(cov_in > 16) cov_in = 16;
+        }
+
+        if(cov_out == 16 && cov_in == 16) {
+            /*The fully covered pixels are drawn together*/
+            full_end = lv_ccache_aa_span(2 * r_out, dy);
+            if(full_end < dx) full_end = dx;
+
+            if(row->full_start > dx) row->full_start = dx;
+            row->full_end = full_end;
+            dx = full_end + 1;
+        } else {
+            if(cov_in < cov_out) cov_out = cov_in;
+            cov_a[dx] = cov_out;
+            dx++;
+        }
+    }
+
+    row->end = dx - 1;
+
+    /*Keep 'full_start' after the partially covered pixels if there is no fully covered one*/
+    if(row->full_end < row->full_start) {
+        row->full_start = row->end + 1;
+        row->full_end = row->end;
+    }
+}
+
+/**
+ * Get the last pixel in a row which is in a circle
+ * @param d2 diameter of the circle (2 * radius)
+ * @param dy distance of the row from the center
+ * @return the last 'dx' distance in the circle (-1 if the row is out of the circle)
+ */
+static cord_t lv_ccache_aa_span(int32_t d2, cord_t dy)
+{
+    /* (2 * dx)^2 + (2 * dy)^2 <= d2^2*/
+    int32_t v = d2 * d2 - 4 * (int32_t)dy * dy;
+    if(d2 < 0 || v < 0) return -1;
+
+    return lv_ccache_aa_sqrt(v >> 2);
+}
+
+/**
+ * Integer square root
+ * @param x a number
+ * @return the square root of 'x' rounded down
+ */
+static uint32_t lv_ccache_aa_sqrt(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = (uint32_t)1 << 30;
+
+    while(bit > x) bit >>= 2;
+
+    while(bit != 0) {
+        if(x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return res;
+}
+#endif
+
+/**
+ * Get the memory needed for the rows of a corner
+ * @param radius radius of the rectangle
+ * @return size in bytes
+ */
+static uint32_t lv_ccache_data_size(cord_t radius)
+{
+    uint32_t row_num = radius + 1;
+#if LV_EDGE_AA == 0
+    return row_num * sizeof(lv_ccache_row_t);
+#else
+    /*The coverage of the pixels too*/
+    return row_num * (sizeof(lv_ccache_row_t) + row_num);
+#endif
+}
+
+/**
+ * Remove an entry from the cache and free its memory
+ * @param entry pointer to an entry of 'lru_ll'
+ */
+static void lv_ccache_rem(lv_ccache_entry_t * entry)
+{
+    cache_size -= lv_ccache_data_size(entry->corner.radius) + sizeof(lv_ccache_entry_t);
+    corner_num --;
+
+    dm_free(entry->data);
+    ll_rem(&lru_ll, entry);
+    dm_free(entry);
+}
+
+#endif /*LV_CCACHE_SIZE != 0*/
@@ -0,0 +1,121 @@
+/**
+ * @file lv_ccache.h
+ * Corner cache: the rows of the rounded corners (body and border) as ready-to-draw spans
+ */
+
+#ifndef LV_CCACHE_H
+#define LV_CCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_CCACHE_SIZE
+#define LV_CCACHE_SIZE      0
+#endif
+
+#ifndef LV_EDGE_AA
+#define LV_EDGE_AA          0
+#endif
+
+#if LV_CCACHE_SIZE != 0
+
+#include <stdint.h>
+#include "misc/gfx/area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A row of a corner. The distances are measured from the center of the corner.
+ * The pixels between 'full_start' and 'full_end' are fully covered,
+ * the others have a coverage (only with LV_EDGE_AA)*/
+typedef struct
+{
+    cord_t start;           /*The first pixel*/
+    cord_t full_start;      /*The first fully covered pixel*/
+    cord_t full_end;        /*The last fully covered pixel (< 'full_start' if none)*/
+    cord_t end;             /*The last pixel (< 'start' if the row is empty)*/
+}lv_ccache_row_t;
+
+/*The right bottom corner of a rectangle's body or border. The other corners are mirrored.*/
+typedef struct
+{
+    const lv_ccache_row_t * row_a;  /*'radius + 1' rows. Row 'i' is 'i' pixels below the center*/
+#if LV_EDGE_AA != 0
+    const uint8_t * cov_a;          /*Coverage of the pixels (0..16). Row 'i' starts at 'i * (radius + 1)'*/
+#endif
+    cord_t radius;                  /*Radius of the rectangle (after the size correction)*/
+    cord_t bwidth;                  /*Border width of the style or 0 for the body*/
+    uint8_t temp :1;                /*1: not cached, freed by 'lv_ccache_release'*/
+}lv_ccache_corner_t;
+
+typedef struct
+{
+    uint32_t hit;           /*Number of corners found in the cache*/
+    uint32_t miss;          /*Number of calculated corners*/
+    uint32_t size;          /*Used memory in bytes*/
+    uint16_t corner_num;    /*Number of cached corners*/
+}lv_ccache_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the corner cache
+ */
+void lv_ccache_init(void);
+
+/**
+ * Get a corner. Calculate it if not cached yet.
+ * The least recently used corners are dropped to keep the memory under LV_CCACHE_SIZE.
+ * @param radius radius of the rectangle (already corrected with its size)
+ * @param bwidth border width from the style or 0 to get the corner of the body
+ * @return pointer to the corner or NULL if there is no enough memory.
+ *         Give it back with 'lv_ccache_release' when the corner is drawn.
+ */
+const lv_ccache_corner_t * lv_ccache_get(cord_t radius, cord_t bwidth);
+
+/**
+ * Give back a corner got with 'lv_ccache_get'. Free it if it was too large to cache.
+ * @param corner pointer to a corner
+ */
+void lv_ccache_release(const lv_ccache_corner_t * corner);
+
+/**
+ * Remove all corners from the cache
+ */
+void lv_ccache_clear(void);
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_ccache_stat_t' variable to store the result
+ */
+void lv_ccache_get_stat(lv_ccache_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_ccache_reset_stat(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_CCACHE_SIZE != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_CCACHE_H*/
@@ -0,0 +1,422 @@
+/**
+ * @file lv_dlist.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_dlist.h"
+
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+
+#include <stddef.h>
+#include <string.h>
+#include "lv_draw.h"
+#include "lv_draw_vbasic.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_DLIST_ALIGN(s)   (((s) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum
+{
+    LV_DLIST_RECT,
+    LV_DLIST_LABEL,
+    LV_DLIST_IMG,
+    LV_DLIST_LINE,
+    LV_DLIST_MAP,
+    LV_DLIST_TRIANGLE,
+}lv_dlist_type_t;
+
+/*The common part of the commands*/
+typedef struct
+{
+    uint16_t size;          /*Size of the command in bytes (aligned)*/
+    uint8_t type;           /*From 'lv_dlist_type_t'*/
+    area_t mask;            /*The original mask of the drawing*/
+}lv_dlist_hdr_t;
+
+typedef struct
+{
+    lv_dlist_hdr_t hdr;
+    area_t cords;
+    lv_style_t style;
+}lv_dlist_rect_t;
+
+/*Followed by 'line_num + 1' lines (if 'lines_en') and the text*/
+typedef struct
+{
+    lv_dlist_hdr_t hdr;
+    area_t cords;
+    lv_style_t style;
+    point_t offset;
+    txt_flag_t flag;
+    uint16_t line_num;
+    uint8_t offset_en :1;
+    uint8_t lines_en :1;
+}lv_dlist_label_t;
+
+/*Followed by the file name (if 'fn_en')*/
+typedef struct
+{
+    lv_dlist_hdr_t hdr;
+    area_t cords;
+    lv_style_t style;
+    uint8_t fn_en :1;
+}lv_dlist_img_t;
+
+typedef struct
+{
+    lv_dlist_hdr_t hdr;
+    point_t p1;
+    point_t p2;
+    lv_style_t style;
+}lv_dlist_line_t;
+
+typedef struct
+{
+    lv_dlist_hdr_t hdr;
+    area_t cords;
+    const color_t * map;
+    color_t recolor;
+    opa_t opa;
+    opa_t recolor_opa;
+    uint8_t transp :1;
+    uint8_t upscale :1;
+}lv_dlist_map_t;
+
+typedef struct
+{
+    lv_dlist_hdr_t hdr;
+    point_t points[3];
+    color_t color;
+}lv_dlist_triangle_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * lv_dlist_add(lv_dlist_type_t type, const area_t * mask_p, uint32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t dlist_buf[LV_DLIST_SIZE] __attribute__ ((aligned (8)));
+static uint32_t dlist_len;      /*Used bytes in 'dlist_buf'*/
+static bool dlist_rec;          /*The recording is active*/
+static bool dlist_full;         /*A drawing didn't fit into the buffer*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start to record the drawings. The 'lv_draw_...' functions will save their parameters
+ * instead of drawing until 'lv_dlist_stop'
+ */
+void lv_dlist_start(void)
+{
+    dlist_len = 0;
+    dlist_full = false;
+    dlist_rec = true;
+}
+
+/**
+ * Stop the recording
+ * @return true: all drawings are recorded; false: the display list was full (the drawings are lost)
+ */
+bool lv_dlist_stop(void)
+{
+    dlist_rec = false;
+
+    return dlist_full == false ? true : false;
+}
+
+/**
+ * Pause the recording to draw directly (e.g. into a layer)
+ * @return true: the recording was active (resume it with 'lv_dlist_resume')
+ */
+bool lv_dlist_pause(void)
+{
+    bool rec = dlist_rec;
+    dlist_rec = false;
+
+    return rec;
+}
+
+/**
+ * Resume the recording after 'lv_dlist_pause'
+ */
+void lv_dlist_resume(void)
+{
+    dlist_rec = true;
+}
+
+/**
+ * Draw the recorded drawings which are on a mask
+ * @param mask_p the drawings will be drawn only on this area (typically the area of the VDB)
+ */
+void lv_dlist_replay(const area_t * mask_p)
+{
+    uint32_t i = 0;
+    lv_dlist_hdr_t * hdr;
+    area_t mask;
+
+    while(i < dlist_len) {
+        hdr = (lv_dlist_hdr_t *) &dlist_buf[i];
+        i += hdr->size;
+
+        /*Skip the drawings which are not on the mask*/
+        if(area_union(&mask, &hdr->mask, mask_p) == false) continue;
+
+        if(hdr->type == LV_DLIST_RECT) {
+            lv_dlist_rect_t * cmd = (lv_dlist_rect_t *) hdr;
+            lv_draw_rect(&cmd->cords, &mask, &cmd->style);
+        }
+        else if(hdr->type == LV_DLIST_LABEL) {
+            lv_dlist_label_t * cmd = (lv_dlist_label_t *) hdr;
+            point_t * offset = cmd->offset_en != 0 ? &cmd->offset : NULL;
+            if(cmd->lines_en != 0) {
+                const lv_draw_label_line_t * lines = (lv_draw_label_line_t *) ((uint8_t *) cmd + sizeof(lv_dlist_label_t));
+                const char * txt = (const char *) &lines[cmd->line_num + 1];
+                lv_draw_label_lines(&cmd->cords, &mask, &cmd->style, txt, cmd->flag, offset, lines, cmd->line_num);
+            } else {
+                const char * txt = (const char *) cmd + sizeof(lv_dlist_label_t);
+                lv_draw_label(&cmd->cords, &mask, &cmd->style, txt, cmd->flag, offset);
+            }
+        }
+        else if(hdr->type == LV_DLIST_IMG) {
+            lv_dlist_img_t * cmd = (lv_dlist_img_t *) hdr;
+            const char * fn = cmd->fn_en != 0 ? (const char *) cmd + sizeof(lv_dlist_img_t) : NULL;
+            lv_draw_img(&cmd->cords, &mask, &cmd->style, fn);
+        }
+        else if(hdr->type == LV_DLIST_LINE) {
+            lv_dlist_line_t * cmd = (lv_dlist_line_t *) hdr;
+            lv_draw_line(&cmd->p1, &cmd->p2, &mask, &cmd->style);
+        }
+        else if(hdr->type == LV_DLIST_MAP) {
+            lv_dlist_map_t * cmd = (lv_dlist_map_t *) hdr;
+            lv_vmap(&cmd->cords, &mask, cmd->map, cmd->opa, cmd->transp != 0 ? true : false,
+                    cmd->upscale != 0 ? true : false, cmd->recolor, cmd->recolor_opa);
+        }
+#if USE_LV_TRIANGLE != 0
+        else if(hdr->type == LV_DLIST_TRIANGLE) {
+            lv_dlist_triangle_t * cmd = (lv_dlist_triangle_t *) hdr;
+            lv_draw_triangle(cmd->points, &mask, cmd->color);
+        }
+#endif
+    }
+}
+
+/**
+ * Record a rectangle (see 'lv_draw_rect')
+ * @param cords_p the coordinates of the rectangle
+ * @param mask_p the rectangle will be drawn only in this mask
+ * @param style_p pointer to a style
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_rect(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p)
+{
+    if(dlist_rec == false) return false;
+
+    lv_dlist_rect_t * cmd = lv_dlist_add(LV_DLIST_RECT, mask_p, sizeof(lv_dlist_rect_t));
+    if(cmd == NULL) return true;
+
+    area_cpy(&cmd->cords, cords_p);
+    memcpy(&cmd->style, style_p, sizeof(lv_style_t));
+
+#if LV_REFR_THREAD_NUM > 1
+    /*The rectangle will be drawn on more threads*/
+    lv_draw_rect_prepare(cords_p, style_p);
+#endif
+
+    return true;
+}
+
+/**
+ * Record a text (see 'lv_draw_label' and 'lv_draw_label_lines')
+ * @param cords_p coordinates of the label
+ * @param mask_p the label will be drawn only in this area
+ * @param style_p pointer to a style
+ * @param txt 0 terminated text to write
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @param offset text offset in x and y direction (NULL if unused)
+ * @param lines array of the lines (NULL to break the lines in 'lv_draw_label')
+ * @param line_num number of lines
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_label(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p,
+                        const char * txt, txt_flag_t flag, const point_t * offset,
+                        const lv_draw_label_line_t * lines, uint16_t line_num)
+{
+    if(dlist_rec == false) return false;
+
+    /*The text can be a temporary buffer of the design function so copy it too*/
+    uint32_t txt_size = strlen(txt) + 1;
+    uint32_t lines_size = lines != NULL ? (line_num + 1) * sizeof(lv_draw_label_line_t) : 0;
+
+    lv_dlist_label_t * cmd = lv_dlist_add(LV_DLIST_LABEL, mask_p, sizeof(lv_dlist_label_t) + lines_size + txt_size);
+    if(cmd == NULL) return true;
+
+    area_cpy(&cmd->cords, cords_p);
+    memcpy(&cmd->style, style_p, sizeof(lv_style_t));
+    cmd->flag = flag;
+    cmd->line_num = line_num;
+    cmd->lines_en = lines != NULL ? 1 : 0;
+    cmd->offset_en = offset != NULL ? 1 : 0;
+    if(offset != NULL) {
+        cmd->offset.x = offset->x;
+        cmd->offset.y = offset->y;
+    }
+
+    uint8_t * data_p = (uint8_t *) cmd + sizeof(lv_dlist_label_t);
+    if(lines != NULL) memcpy(data_p, lines, lines_size);
+    memcpy(data_p + lines_size, txt, txt_size);
+
+    return true;
+}
+
+/**
+ * Record an image (see 'lv_draw_img')
+ * @param cords_p the coordinates of the image
+ * @param mask_p the image will be drawn only in this area
+ * @param style_p pointer to a style
+ * @param fn file name of the image
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_img(const area_t * cords_p, const area_t * mask_p,
+                      const lv_style_t * style_p, const char * fn)
+{
+    if(dlist_rec == false) return false;
+
+    uint32_t fn_size = fn != NULL ? strlen(fn) + 1 : 0;
+
+    lv_dlist_img_t * cmd = lv_dlist_add(LV_DLIST_IMG, mask_p, sizeof(lv_dlist_img_t) + fn_size);
+    if(cmd == NULL) return true;
+
+    area_cpy(&cmd->cords, cords_p);
+    memcpy(&cmd->style, style_p, sizeof(lv_style_t));
+    cmd->fn_en = fn != NULL ? 1 : 0;
+    if(fn != NULL) memcpy((uint8_t *) cmd + sizeof(lv_dlist_img_t), fn, fn_size);
+
+    return true;
+}
+
+/**
+ * Record a line (see 'lv_draw_line')
+ * @param p1 first point of the line
+ * @param p2 second point of the line
+ * @param mask_p the line will be drawn only on this area
+ * @param style_p pointer to a style
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_line(const point_t * p1, const point_t * p2, const area_t * mask_p,
+                       const lv_style_t * style_p)
+{
+    if(dlist_rec == false) return false;
+
+    lv_dlist_line_t * cmd = lv_dlist_add(LV_DLIST_LINE, mask_p, sizeof(lv_dlist_line_t));
+    if(cmd == NULL) return true;
+
+    cmd->p1.x = p1->x;
+    cmd->p1.y = p1->y;
+    cmd->p2.x = p2->x;
+    cmd->p2.y = p2->y;
+    memcpy(&cmd->style, style_p, sizeof(lv_style_t));
+
+    return true;
+}
+
+/**
+ * Record a color map (see 'lv_vmap'). The map is not copied, it has to be valid until the replay.
+ * @param cords_p coordinates the color map
+ * @param mask_p the map will drawn only on this area
+ * @param map_p pointer to a color_t array
+ * @param opa opacity of the map
+ * @param transp true: enable transparency of LV_IMG_COLOR_TRANSP color pixels
+ * @param upscale true: upscale to double size
+ * @param recolor mix the pixels with this color
+ * @param recolor_opa the intense of recoloring
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_map(const area_t * cords_p, const area_t * mask_p,
+                      const color_t * map_p, opa_t opa, bool transp, bool upscale,
+                      color_t recolor, opa_t recolor_opa)
+{
+    if(dlist_rec == false) return false;
+
+    lv_dlist_map_t * cmd = lv_dlist_add(LV_DLIST_MAP, mask_p, sizeof(lv_dlist_map_t));
+    if(cmd == NULL) return true;
+
+    area_cpy(&cmd->cords, cords_p);
+    cmd->map = map_p;
+    cmd->opa = opa;
+    cmd->transp = transp != false ? 1 : 0;
+    cmd->upscale = upscale != false ? 1 : 0;
+    cmd->recolor = recolor;
+    cmd->recolor_opa = recolor_opa;
+
+    return true;
+}
+
+#if USE_LV_TRIANGLE != 0
+/**
+ * Record a triangle (see 'lv_draw_triangle')
+ * @param points pointer to an array with 3 points
+ * @param mask_p the triangle will be drawn only in this mask
+ * @param color color of the triangle
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_triangle(const point_t * points, const area_t * mask_p, color_t color)
+{
+    if(dlist_rec == false) return false;
+
+    lv_dlist_triangle_t * cmd = lv_dlist_add(LV_DLIST_TRIANGLE, mask_p, sizeof(lv_dlist_triangle_t));
+    if(cmd == NULL) return true;
+
+    memcpy(cmd->points, points, sizeof(cmd->points));
+    cmd->color = color;
+
+    return true;
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Allocate a new command at the end of the display list
+ * @param type type of the command
+ * @param mask_p the mask of the drawing
+ * @param size size of the command with its data
+ * @return pointer to the new command or NULL if it doesn't fit (the list is marked as full)
+ */
+static void * lv_dlist_add(lv_dlist_type_t type, const area_t * mask_p, uint32_t size)
+{
+    size = LV_DLIST_ALIGN(size);
+    if(dlist_full != false || dlist_len + size > LV_DLIST_SIZE || size > UINT16_MAX) {
+        dlist_full = true;
+        return NULL;
+    }
+
+    lv_dlist_hdr_t * hdr = (lv_dlist_hdr_t *) &dlist_buf[dlist_len];
+    hdr->size = size;
+    hdr->type = type;
+    area_cpy(&hdr->mask, mask_p);
+
+    dlist_len += size;
+
+    return hdr;
+}
+
+#endif /*LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0*/
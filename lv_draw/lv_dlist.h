@@ -0,0 +1,156 @@
+/**
+ * @file lv_dlist.h
+ * Display list: record the drawings of the design functions once and replay them in every VDB band
+ */
+
+#ifndef LV_DLIST_H
+#define LV_DLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_DLIST_SIZE
+#define LV_DLIST_SIZE       0
+#endif
+
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+
+#include <stdbool.h>
+#include "misc/gfx/area.h"
+#include "misc/gfx/color.h"
+#include "misc/gfx/text.h"
+#include "../lv_obj/lv_style.h"
+#include "lv_draw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start to record the drawings. The 'lv_draw_...' functions will save their parameters
+ * instead of drawing until 'lv_dlist_stop'
+ */
+void lv_dlist_start(void);
+
+/**
+ * Stop the recording
+ * @return true: all drawings are recorded; false: the display list was full (the drawings are lost)
+ */
+bool lv_dlist_stop(void);
+
+/**
+ * Pause the recording to draw directly (e.g. into a layer)
+ * @return true: the recording was active (resume it with 'lv_dlist_resume')
+ */
+bool lv_dlist_pause(void);
+
+/**
+ * Resume the recording after 'lv_dlist_pause'
+ */
+void lv_dlist_resume(void);
+
+/**
+ * Draw the recorded drawings which are on a mask
+ * @param mask_p the drawings will be drawn only on this area (typically the area of the VDB)
+ */
+void lv_dlist_replay(const area_t * mask_p);
+
+/**
+ * Record a rectangle (see 'lv_draw_rect')
+ * @param cords_p the coordinates of the rectangle
+ * @param mask_p the rectangle will be drawn only in this mask
+ * @param style_p pointer to a style
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_rect(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p);
+
+/**
+ * Record a text (see 'lv_draw_label' and 'lv_draw_label_lines')
+ * @param cords_p coordinates of the label
+ * @param mask_p the label will be drawn only in this area
+ * @param style_p pointer to a style
+ * @param txt 0 terminated text to write
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @param offset text offset in x and y direction (NULL if unused)
+ * @param lines array of the lines (NULL to break the lines in 'lv_draw_label')
+ * @param line_num number of lines
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_label(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p,
+                        const char * txt, txt_flag_t flag, const point_t * offset,
+                        const lv_draw_label_line_t * lines, uint16_t line_num);
+
+/**
+ * Record an image (see 'lv_draw_img')
+ * @param cords_p the coordinates of the image
+ * @param mask_p the image will be drawn only in this area
+ * @param style_p pointer to a style
+ * @param fn file name of the image
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_img(const area_t * cords_p, const area_t * mask_p,
+                      const lv_style_t * style_p, const char * fn);
+
+/**
+ * Record a line (see 'lv_draw_line')
+ * @param p1 first point of the line
+ * @param p2 second point of the line
+ * @param mask_p the line will be drawn only on this area
+ * @param style_p pointer to a style
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_line(const point_t * p1, const point_t * p2, const area_t * mask_p,
+                       const lv_style_t * style_p);
+
+/**
+ * Record a color map (see 'lv_vmap'). The map is not copied, it has to be valid until the replay.
+ * @param cords_p coordinates the color map
+ * @param mask_p the map will drawn only on this area
+ * @param map_p pointer to a color_t array
+ * @param opa opacity of the map
+ * @param transp true: enable transparency of LV_IMG_COLOR_TRANSP color pixels
+ * @param upscale true: upscale to double size
+ * @param recolor mix the pixels with this color
+ * @param recolor_opa the intense of recoloring
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_map(const area_t * cords_p, const area_t * mask_p,
+                      const color_t * map_p, opa_t opa, bool transp, bool upscale,
+                      color_t recolor, opa_t recolor_opa);
+
+#if USE_LV_TRIANGLE != 0
+/**
+ * Record a triangle (see 'lv_draw_triangle')
+ * @param points pointer to an array with 3 points
+ * @param mask_p the triangle will be drawn only in this mask
+ * @param color color of the triangle
+ * @return true: recorded (don't draw it now); false: the recording is not active
+ */
+bool lv_dlist_rec_triangle(const point_t * points, const area_t * mask_p, color_t color);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DLIST_H*/
@@ -18,7 +18,13 @@
 #include "lv_draw_rbasic.h"
 #include "lv_draw_vbasic.h"
 #include "misc/fs/ufs/ufs.h"
+#include "../lv_obj/lv_prof.h"
+#include "../lv_obj/lv_tpool.h"
 #include "../lv_objx/lv_img.h"
+#include "lv_dlist.h"
+#include "lv_scache.h"
+#include "lv_ccache.h"
+#include "lv_grad.h"
 
 /*********************
  *      DEFINES
@@ -28,6 +34,19 @@
 
 #define LABEL_RECOLOR_PAR_LENGTH    6
 
+#ifndef LV_EDGE_AA
+#define LV_EDGE_AA      0
+#endif
+
+/*The file system is shared by the rendering threads. Lock it only for the file operations.*/
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+#define LV_DRAW_FS_LOCK()       do {if(lv_tpool_busy() != false) lv_tpool_lock();} while(0)
+#define LV_DRAW_FS_UNLOCK()     do {if(lv_tpool_busy() != false) lv_tpool_unlock();} while(0)
+#else
+#define LV_DRAW_FS_LOCK()
+#define LV_DRAW_FS_UNLOCK()
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -42,16 +61,41 @@ typedef enum
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_draw_rect_main_mid(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style);
-static void lv_draw_rect_main_corner(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p);
+static void lv_draw_rect_main_mid(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style,
+                                  const lv_grad_t * grad);
+static void lv_draw_rect_main_corner(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p,
+                                     const lv_grad_t * grad);
+static void lv_draw_rect_main_fill(const area_t * area_p, const area_t * mask_p, const lv_style_t * style,
+                                   const lv_grad_t * grad);
 static void lv_draw_rect_border_straight(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p);
 static void lv_draw_rect_border_corner(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style);
 static void lv_draw_rect_shadow(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style);
 static void lv_draw_cont_shadow_full(const area_t * cords_p, const area_t * mask_p, const  lv_style_t * style);
 static void lv_draw_cont_shadow_bottom(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style);
 static void lv_draw_cont_shadow_full_straight(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style, const opa_t * map);
+#if LV_SCACHE_SIZE != 0
+static void lv_draw_cont_shadow_full_cached(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style,
+                                            const lv_scache_shadow_t * shadow);
+#endif
 
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, cord_t w, cord_t h);
+#if LV_CCACHE_SIZE != 0
+static void lv_draw_rect_corner_cached(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style,
+                                       const lv_ccache_corner_t * corner, const lv_grad_t * grad);
+#endif
+static void lv_draw_label_letters(point_t * pos_p, const area_t * mask_p, const lv_style_t * style,
+                                  const char * txt, uint32_t start, uint32_t end, txt_flag_t flag);
+
+#if LV_EDGE_AA != 0
+static void lv_draw_rect_main_corner_aa(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p,
+                                        const lv_grad_t * grad);
+static void lv_draw_rect_border_corner_aa(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style);
+static void lv_draw_line_aa(const point_t * p1, const point_t * p2, const area_t * mask_p, const lv_style_t * style);
+static void lv_draw_aa_corner_row(cord_t ox, cord_t y, int8_t dir, cord_t dy, cord_t r_out, cord_t r_in,
+                                  const area_t * mask_p, color_t color, const lv_grad_t * grad, opa_t opa);
+static cord_t lv_draw_aa_span(int32_t d2, cord_t dy);
+static uint32_t lv_draw_aa_sqrt(uint32_t x);
+#endif
 
 
 #if USE_LV_TRIANGLE != 0
@@ -66,11 +110,19 @@ static void (*px_fp)(cord_t x, cord_t y, const area_t * mask_p, color_t color, o
 static void (*fill_fp)(const area_t * cords_p, const area_t * mask_p, color_t color, opa_t opa) =  lv_vfill;
 static void (*letter_fp)(const point_t * pos_p, const area_t * mask_p, const font_t * font_p, uint8_t letter, color_t color, opa_t opa) = lv_vletter;
 static void (*map_fp)(const area_t * cords_p, const area_t * mask_p, const color_t * map_p, opa_t opa, bool transp, bool upscale, color_t recolor, opa_t recolor_opa) = lv_vmap;
+static void (*grad_fill_fp)(const area_t * cords_p, const area_t * mask_p, const lv_grad_t * grad, opa_t opa) = lv_vfill_grad;
+#if LV_SCACHE_SIZE != 0
+static void (*px_row_fp)(cord_t x, cord_t y, int8_t dir, const area_t * mask_p, color_t color, const opa_t * opa_a, uint16_t len) = lv_vpx_row;
+#endif
 #else
 static void (*px_fp)(cord_t x, cord_t y, const area_t * mask_p, color_t color, opa_t opa) = lv_rpx;
 static void (*fill_fp)(const area_t * cords_p, const area_t * mask_p, color_t color, opa_t opa) =  lv_rfill;
 static void (*letter_fp)(const point_t * pos_p, const area_t * mask_p, const font_t * font_p, uint8_t letter, color_t color, opa_t opa) = lv_rletter;
 static void (*map_fp)(const area_t * cords_p, const area_t * mask_p, const color_t * map_p, opa_t opa, bool transp, bool upscale, color_t recolor, opa_t recolor_opa) = lv_rmap;
+static void (*grad_fill_fp)(const area_t * cords_p, const area_t * mask_p, const lv_grad_t * grad, opa_t opa) = lv_rfill_grad;
+#if LV_SCACHE_SIZE != 0
+static void (*px_row_fp)(cord_t x, cord_t y, int8_t dir, const area_t * mask_p, color_t color, const opa_t * opa_a, uint16_t len) = lv_rpx_row;
+#endif
 #endif
 
 
@@ -92,28 +144,107 @@ void lv_draw_rect(const area_t * cords_p, const area_t * mask_p, const lv_style_
 {
     if(area_get_height(cords_p) < 1 || area_get_width(cords_p) < 1) return;
 
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+    if(lv_dlist_rec_rect(cords_p, mask_p, style_p) != false) return;
+#endif
+
+#if LV_PROF != 0
+    uint32_t prof_start = lv_prof_start();
+#endif
+
     if(style_p->swidth != 0) {
+#if LV_PROF != 0
+        uint32_t prof_shadow_start = lv_prof_start();
+        lv_draw_rect_shadow(cords_p, mask_p, style_p);
+        lv_prof_prim_end(LV_PROF_PRIM_SHADOW, prof_shadow_start);
+#else
         lv_draw_rect_shadow(cords_p, mask_p, style_p);
+#endif
     }
 
     if(style_p->empty == 0){
-        lv_draw_rect_main_mid(cords_p, mask_p, style_p);
+        /*Get the colors of the gradient once for the middle and the corners*/
+        lv_grad_t grad;
+        lv_grad_t * grad_p = NULL;
+        if(style_p->mcolor.full != style_p->gcolor.full) {
+            if(lv_grad_get(&grad, cords_p, style_p) != false) grad_p = &grad;
+        }
+
+        lv_draw_rect_main_mid(cords_p, mask_p, style_p, grad_p);
 
         if(style_p->radius != 0) {
-            lv_draw_rect_main_corner(cords_p, mask_p, style_p);
+#if LV_EDGE_AA == 0
+            lv_draw_rect_main_corner(cords_p, mask_p, style_p, grad_p);
+#else
+            lv_draw_rect_main_corner_aa(cords_p, mask_p, style_p, grad_p);
+#endif
         }
+
+        if(grad_p != NULL) lv_grad_release(grad_p);
     } 
     
     if(style_p->bwidth != 0) {
         lv_draw_rect_border_straight(cords_p, mask_p, style_p);
 
         if(style_p->radius != 0) {
+#if LV_EDGE_AA == 0
             lv_draw_rect_border_corner(cords_p, mask_p, style_p);
+#else
+            lv_draw_rect_border_corner_aa(cords_p, mask_p, style_p);
+#endif
         }
     }
+
+#if LV_PROF != 0
+    lv_prof_prim_end(LV_PROF_PRIM_RECT, prof_start);
+#endif
 }
 
-#if USE_LV_TRIANGE != 0
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+/**
+ * Prepare the cached data of a rectangle (e.g. its shadow) before drawing it on more threads
+ * @param cords_p the coordinates of the rectangle
+ * @param style_p pointer to a style
+ */
+void lv_draw_rect_prepare(const area_t * cords_p, const lv_style_t * style_p)
+{
+#if LV_SCACHE_SIZE != 0
+    /*The threads only read the shadow cache*/
+    if(style_p->swidth != 0 && style_p->stype == LV_STYPE_FULL) {
+        cord_t radius = lv_draw_cont_radius_corr(style_p->radius, area_get_width(cords_p), area_get_height(cords_p));
+        const lv_scache_shadow_t * shadow = lv_scache_get(radius, style_p->swidth, style_p->opa);
+        if(shadow != NULL) lv_scache_release(shadow);
+    }
+#endif
+
+#if LV_GRAD_CACHE_SIZE != 0
+    /*The threads only read the gradient cache too*/
+    if(style_p->empty == 0 && style_p->mcolor.full != style_p->gcolor.full) {
+        lv_grad_t grad;
+        if(lv_grad_get(&grad, cords_p, style_p) != false) lv_grad_release(&grad);
+    }
+#endif
+
+#if LV_CCACHE_SIZE != 0
+    /*The threads only read the corner cache too*/
+    if(style_p->radius != 0) {
+        cord_t radius = lv_draw_cont_radius_corr(style_p->radius, area_get_width(cords_p), area_get_height(cords_p));
+        const lv_ccache_corner_t * corner;
+        if(style_p->empty == 0) {
+            corner = lv_ccache_get(radius, 0);
+            if(corner != NULL) lv_ccache_release(corner);
+        }
+
+        if(style_p->bwidth != 0) {
+            corner = lv_ccache_get(radius, style_p->bwidth);
+            if(corner != NULL) lv_ccache_release(corner);
+        }
+    }
+#endif
+}
+#endif
+
+#if USE_LV_TRIANGLE != 0
 /**
  *
  * @param points pointer to an array with 3 points
@@ -122,6 +253,10 @@ void lv_draw_rect(const area_t * cords_p, const area_t * mask_p, const lv_style_
  */
 void lv_draw_triangle(const point_t * points, const area_t * mask_p, color_t color)
 {
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+    if(lv_dlist_rec_triangle(points, mask_p, color) != false) return;
+#endif
+
     point_t tri[3];
 
     memcpy(tri, points, sizeof(tri));
@@ -234,6 +369,14 @@ void lv_draw_triangle(const point_t * points, const area_t * mask_p, color_t col
 void lv_draw_label(const area_t * cords_p,const area_t * mask_p, const lv_style_t * style,
                     const char * txt, txt_flag_t flag, point_t * offset)
 {
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+    if(lv_dlist_rec_label(cords_p, mask_p, style, txt, flag, offset, NULL, 0) != false) return;
+#endif
+
+#if LV_PROF != 0
+    uint32_t prof_start = lv_prof_start();
+#endif
+
     const font_t * font = style->font;
     cord_t w;
 
@@ -260,11 +403,6 @@ void lv_draw_label(const area_t * cords_p,const area_t * mask_p, const lv_style_
         pos.x += (w - line_length) / 2;
     }
 
-    cmd_state_t cmd_state = CMD_STATE_WAIT;
-    uint32_t i;
-    uint16_t par_start;
-    color_t recolor;
-
     if(offset != NULL) {
         pos.y += offset->y;
     }
@@ -275,52 +413,8 @@ void lv_draw_label(const area_t * cords_p,const area_t * mask_p, const lv_style_
             pos.x += offset->x;
         }
         /*Write all letter of a line*/
-        cmd_state = CMD_STATE_WAIT;
-
-        for(i = line_start; i < line_end; i++) {
-            /*Handle the re-color command*/
-            if((flag & TXT_FLAG_RECOLOR) != 0) {
-                if(txt[i] == TXT_RECOLOR_CMD) {
-                    if(cmd_state == CMD_STATE_WAIT) { /*Start char*/
-                        par_start = i + 1;
-                        cmd_state = CMD_STATE_PAR;
-                        continue;
-                    } else if(cmd_state == CMD_STATE_PAR) { /*Other start char in parameter escaped cmd. char */
-                        cmd_state = CMD_STATE_WAIT;
-                    }else if(cmd_state == CMD_STATE_IN) { /*Command end */
-                        cmd_state = CMD_STATE_WAIT;
-                        continue;
-                    }
-                }
-
-                /*Skip the color parameter and wait the space after it*/
-                if(cmd_state == CMD_STATE_PAR) {
-                    if(txt[i] == ' ') {
-                        /*Get the parameter*/
-                        if(i - par_start == LABEL_RECOLOR_PAR_LENGTH) {
-                            char buf[LABEL_RECOLOR_PAR_LENGTH + 1];
-                            memcpy(buf, &txt[par_start], LABEL_RECOLOR_PAR_LENGTH);
-                            buf[LABEL_RECOLOR_PAR_LENGTH] = '\0';
-                            int r,g,b;
-                            sscanf(buf, "%02x%02x%02x", &r, &g, &b);
-                            recolor = COLOR_MAKE(r, g, b);
-                        } else {
-                            recolor.full = style->ccolor.full;
-                        }
-                        cmd_state = CMD_STATE_IN; /*After the parameter the text is in the command*/
-                    }
-                    continue;
-                }
-            }
-
-            color_t color = style->ccolor;
-
-            if(cmd_state == CMD_STATE_IN) color = recolor;
-            letter_fp(&pos, mask_p, font, txt[i], color, style->opa);
+        lv_draw_label_letters(&pos, mask_p, style, txt, line_start, line_end, flag);
 
-            pos.x += (font_get_width(font, txt[i]) >> FONT_ANTIALIAS) + style->letter_space;
-
-        }
         /*Go to next line*/
         line_start = line_end;
         line_end += txt_get_next_line(&txt[line_start], font, style->letter_space, w, flag);
@@ -336,6 +430,78 @@ void lv_draw_label(const area_t * cords_p,const area_t * mask_p, const lv_style_
         pos.y += font_get_height(font) >> FONT_ANTIALIAS;
         pos.y += style->line_space;
     }
+
+#if LV_PROF != 0
+    lv_prof_prim_end(LV_PROF_PRIM_LABEL, prof_start);
+#endif
+}
+
+/**
+ * Write a text with pre-calculated line breaks (e.g. cached by the object)
+ * @param cords_p coordinates of the label
+ * @param mask_p the label will be drawn only in this area
+ * @param style pointer to a style
+ * @param txt 0 terminated text to write
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @param offset text offset in x and y direction (NULL if unused)
+ * @param lines array of the lines. 'lines[line_num].start' has to be the end of the last line.
+ * @param line_num number of lines
+ */
+void lv_draw_label_lines(const area_t * cords_p,const area_t * mask_p, const lv_style_t * style,
+                         const char * txt, txt_flag_t flag, point_t * offset,
+                         const lv_draw_label_line_t * lines, uint16_t line_num)
+{
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+    if(lv_dlist_rec_label(cords_p, mask_p, style, txt, flag, offset, lines, line_num) != false) return;
+#endif
+
+#if LV_PROF != 0
+    uint32_t prof_start = lv_prof_start();
+#endif
+
+    const font_t * font = style->font;
+    cord_t letter_h = font_get_height(font) >> FONT_ANTIALIAS;
+    cord_t w;
+    uint16_t i;
+
+    if((flag & TXT_FLAG_EXPAND) == 0) {
+        w = area_get_width(cords_p);
+    } else {
+        /*The text is as wide as the longest line*/
+        w = 0;
+        for(i = 0; i < line_num; i++) {
+            if(lines[i].w > w) w = lines[i].w;
+        }
+    }
+
+    point_t pos;
+    pos.y = cords_p->y1;
+    if(offset != NULL) {
+        pos.y += offset->y;
+    }
+
+    for(i = 0; i < line_num; i++) {
+        /*Skip the lines above the mask and stop below it*/
+        if(pos.y > mask_p->y2) break;
+        if(pos.y + letter_h > mask_p->y1) {
+            pos.x = cords_p->x1;
+            if(style->txt_align == LV_TXT_ALIGN_MID) {
+                pos.x += (w - lines[i].w) / 2;
+            }
+            if(offset != NULL) {
+                pos.x += offset->x;
+            }
+
+            lv_draw_label_letters(&pos, mask_p, style, txt, lines[i].start, lines[i + 1].start, flag);
+        }
+
+        /*Go the next line position*/
+        pos.y += letter_h + style->line_space;
+    }
+
+#if LV_PROF != 0
+    lv_prof_prim_end(LV_PROF_PRIM_LABEL, prof_start);
+#endif
 }
 
 /**
@@ -348,16 +514,28 @@ void lv_draw_label(const area_t * cords_p,const area_t * mask_p, const lv_style_
 void lv_draw_img(const area_t * cords_p, const area_t * mask_p, 
              const lv_style_t * style, const char * fn)
 {
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+    if(lv_dlist_rec_img(cords_p, mask_p, style, fn) != false) return;
+#endif
+
+#if LV_PROF != 0
+    uint32_t prof_start = lv_prof_start();
+#endif
+
+    bool no_data = false;
     if(fn == NULL) {
-        lv_draw_rect(cords_p, mask_p, lv_style_get(LV_STYLE_PLAIN, NULL));
-        lv_draw_label(cords_p, mask_p, lv_style_get(LV_STYLE_PLAIN, NULL), "No data", TXT_FLAG_NONE, NULL);
+        no_data = true;
     } else {
         fs_file_t file;
+        LV_DRAW_FS_LOCK();
         fs_res_t res = fs_open(&file, fn, FS_MODE_RD);
+        LV_DRAW_FS_UNLOCK();
         if(res == FS_RES_OK) {
             lv_img_raw_header_t header;
             uint32_t br;
+            LV_DRAW_FS_LOCK();
             res = fs_read(&file, &header, sizeof(lv_img_raw_header_t), &br);
+            LV_DRAW_FS_UNLOCK();
 
             /*If the width is greater then real img. width then it is upscaled */
             bool upscale = false;
@@ -367,7 +545,12 @@ void lv_draw_img(const area_t * cords_p, const area_t * mask_p,
             bool union_ok;
             union_ok = area_union(&mask_com, mask_p, cords_p);
             if(union_ok == false) {
+                LV_DRAW_FS_LOCK();
                 fs_close(&file);
+                LV_DRAW_FS_UNLOCK();
+#if LV_PROF != 0
+                lv_prof_prim_end(LV_PROF_PRIM_IMG, prof_start);
+#endif
                 return;
             }
 
@@ -400,7 +583,9 @@ void lv_draw_img(const area_t * cords_p, const area_t * mask_p,
                 start_offset += (area_get_width(cords_p) >> us_shift) *
                                ((mask_com.y1 - cords_p->y1) >> us_shift) * sizeof(color_t); /*First row*/
                 start_offset += ((mask_com.x1 - cords_p->x1) >> us_shift) * sizeof(color_t); /*First col*/
+                LV_DRAW_FS_LOCK();
                 fs_seek(&file, start_offset);
+                LV_DRAW_FS_UNLOCK();
 
                 uint32_t useful_data = (area_get_width(&mask_com) >> us_shift) * sizeof(color_t);
                 uint32_t next_row = (area_get_width(cords_p) >> us_shift) * sizeof(color_t) - useful_data;
@@ -413,25 +598,38 @@ void lv_draw_img(const area_t * cords_p, const area_t * mask_p,
                 uint32_t act_pos;
                 color_t buf[LV_HOR_RES];
                 for(row = mask_com.y1; row <= mask_com.y2; row += us_val) {
+                    LV_DRAW_FS_LOCK();
                     res = fs_read(&file, buf, useful_data, &br);
+                    LV_DRAW_FS_UNLOCK();
 
                     map_fp(&line, &mask_com, buf, style->opa, header.transp, upscale,
                                           style->ccolor, style->img_recolor);
 
+                    LV_DRAW_FS_LOCK();
                     fs_tell(&file, &act_pos);
                     fs_seek(&file, act_pos + next_row);
+                    LV_DRAW_FS_UNLOCK();
                     line.y1 += us_val;    /*Go down a line*/
                     line.y2 += us_val;
                 }
             }
         }
 
+        LV_DRAW_FS_LOCK();
         fs_close(&file);
+        LV_DRAW_FS_UNLOCK();
 
-        if(res != FS_RES_OK) {
-            lv_draw_rect(cords_p, mask_p, lv_style_get(LV_STYLE_PLAIN, NULL));
-            lv_draw_label(cords_p, mask_p, lv_style_get(LV_STYLE_PLAIN, NULL), "No data", TXT_FLAG_NONE, NULL);
-        }
+        if(res != FS_RES_OK) no_data = true;
+    }
+
+#if LV_PROF != 0
+    lv_prof_prim_end(LV_PROF_PRIM_IMG, prof_start);
+#endif
+
+    /*Draw the placeholder after the measurement: the rect and the label are measured by themselves*/
+    if(no_data != false) {
+        lv_draw_rect(cords_p, mask_p, lv_style_get(LV_STYLE_PLAIN, NULL));
+        lv_draw_label(cords_p, mask_p, lv_style_get(LV_STYLE_PLAIN, NULL), "No data", TXT_FLAG_NONE, NULL);
     }
 }
 
@@ -450,6 +648,17 @@ void lv_draw_line(const point_t * p1, const point_t * p2, const area_t * mask_p,
 
 	if(p1->x == p2->x && p1->y == p2->y) return;
 
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+	if(lv_dlist_rec_line(p1, p2, mask_p, style) != false) return;
+#endif
+
+#if LV_PROF != 0
+	uint32_t prof_start = lv_prof_start();
+#endif
+
+#if LV_EDGE_AA != 0
+	lv_draw_line_aa(p1, p2, mask_p, style);
+#else
 	cord_t dx = MATH_ABS(p2->x - p1->x);
 	cord_t sx = p1->x < p2->x ? 1 : -1;
 	cord_t dy = MATH_ABS(p2->y - p1->y);
@@ -561,6 +770,11 @@ void lv_draw_line(const point_t * p1, const point_t * p2, const area_t * mask_p,
 		draw_area.y2 = MATH_MAX(act_area.y1, act_area.y2);
 		fill_fp(&draw_area, mask_p, style->ccolor, style->opa);
 	}
+#endif /*LV_EDGE_AA != 0*/
+
+#if LV_PROF != 0
+	lv_prof_prim_end(LV_PROF_PRIM_LINE, prof_start);
+#endif
 }
 
 
@@ -573,15 +787,12 @@ void lv_draw_line(const point_t * p1, const point_t * p2, const area_t * mask_p,
  * @param cords_p the coordinates of the original rectangle
  * @param mask_p the rectangle will be drawn only  on this area
  * @param rects_p pointer to a rectangle style
+ * @param grad the gradient of the rectangle or NULL to fill with 'mcolor'
  */
-static void lv_draw_rect_main_mid(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style)
+static void lv_draw_rect_main_mid(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style,
+                                  const lv_grad_t * grad)
 {
     uint16_t radius = style->radius;
-
-    color_t mcolor = style->mcolor;
-    color_t gcolor = style->gcolor;
-    uint8_t mix;
-    opa_t opa = style->opa;
     cord_t height = area_get_height(cords_p);
     cord_t width = area_get_width(cords_p);
 
@@ -593,51 +804,54 @@ static void lv_draw_rect_main_mid(const area_t * cords_p, const area_t * mask_p,
 	area_t work_area;
 	work_area.x1 = cords_p->x1;
 	work_area.x2 = cords_p->x2;
+	work_area.y1 = cords_p->y1 + radius;
+	work_area.y2 = cords_p->y2 - radius;
 
-    if(mcolor.full == gcolor.full) {
-    	work_area.y1 = cords_p->y1 + radius;
-    	work_area.y2 = cords_p->y2 - radius;
-		fill_fp(&work_area, mask_p, mcolor, opa);
-    } else {
+	/*The rows of a gradient are filled in one pass too*/
+	lv_draw_rect_main_fill(&work_area, mask_p, style, grad);
+}
 
-		cord_t row;
-		cord_t row_start = cords_p->y1 + radius;
-		cord_t row_end = cords_p->y2 - radius;
-		color_t act_color;
-        if(row_start < 0) row_start = 0;
-		for(row = row_start ;
-			row <= row_end;
-			row ++)
-		{
-			work_area.y1 = row;
-			work_area.y2 = row;
-			mix = (uint32_t)((uint32_t)(cords_p->y2 - work_area.y1) * 255) / height;
-			act_color = color_mix(mcolor, gcolor, mix);
-
-			fill_fp(&work_area, mask_p, act_color, opa);
-		}
-    }
+/**
+ * Fill a part of a rectangle's body
+ * @param area_p the area to fill
+ * @param mask_p the area will be filled only on this mask
+ * @param style pointer to a rectangle style
+ * @param grad the gradient of the rectangle or NULL to fill with 'mcolor'
+ */
+static void lv_draw_rect_main_fill(const area_t * area_p, const area_t * mask_p, const lv_style_t * style,
+                                   const lv_grad_t * grad)
+{
+    if(grad != NULL) grad_fill_fp(area_p, mask_p, grad, style->opa);
+    else fill_fp(area_p, mask_p, style->mcolor, style->opa);
 }
+
 /**
  * Draw the top and bottom parts (corners) of a rectangle
  * @param cords_p the coordinates of the original rectangle
  * @param mask_p the rectangle will be drawn only  on this area
  * @param rects_p pointer to a rectangle style
+ * @param grad the gradient of the rectangle or NULL to fill with 'mcolor'
  */
-static void lv_draw_rect_main_corner(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p)
+static void lv_draw_rect_main_corner(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p,
+                                     const lv_grad_t * grad)
 {
     uint16_t radius = style_p->radius;
 
-    color_t mcolor = style_p->mcolor;
-    color_t gcolor = style_p->gcolor;
-    color_t act_color;
-    opa_t opa = style_p->opa;
-    uint8_t mix;
     cord_t height = area_get_height(cords_p);
     cord_t width = area_get_width(cords_p);
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
+#if LV_CCACHE_SIZE != 0
+    /*Draw the rows of the corners from the cache*/
+    const lv_ccache_corner_t * corner = lv_ccache_get(radius, 0);
+    if(corner != NULL) {
+        lv_draw_rect_corner_cached(cords_p, mask_p, style_p, corner, grad);
+        lv_ccache_release(corner);
+        return;
+    }
+#endif
+
     point_t lt_origo;   /*Left  Top    origo*/
     point_t lb_origo;   /*Left  Bottom origo*/
     point_t rt_origo;   /*Right Top    origo*/
@@ -723,27 +937,19 @@ static void lv_draw_rect_main_corner(const area_t * cords_p, const area_t * mask
 
         /*Draw the areas which are not disabled*/
         if(edge_top_refr != 0){
-            mix = (uint32_t)((uint32_t)(cords_p->y2 - edge_top_area.y1)  * 255) / height;
-            act_color = color_mix(mcolor, gcolor, mix);
-            fill_fp(&edge_top_area, mask_p, act_color, opa);
+            lv_draw_rect_main_fill(&edge_top_area, mask_p, style_p, grad);
         }
 
         if(mid_top_refr != 0) {
-            mix = (uint32_t)((uint32_t)(cords_p->y2 - mid_top_area.y1) * 255) / height;
-            act_color = color_mix(mcolor, gcolor, mix);
-            fill_fp(&mid_top_area, mask_p, act_color, opa);
+            lv_draw_rect_main_fill(&mid_top_area, mask_p, style_p, grad);
         }
 
         if(mid_bot_refr != 0) {
-            mix = (uint32_t)((uint32_t)(cords_p->y2 - mid_bot_area.y1) * 255) / height;
-            act_color = color_mix(mcolor, gcolor, mix);
-            fill_fp(&mid_bot_area, mask_p, act_color, opa);
+            lv_draw_rect_main_fill(&mid_bot_area, mask_p, style_p, grad);
         }
 
         if(edge_bot_refr != 0) {
-            mix = (uint32_t)((uint32_t)(cords_p->y2 - edge_bot_area.y1) * 255) / height;
-            act_color = color_mix(mcolor, gcolor, mix);
-            fill_fp(&edge_bot_area, mask_p, act_color, opa);
+            lv_draw_rect_main_fill(&edge_bot_area, mask_p, style_p, grad);
         }
          /*Save the current coordinates*/
         area_set(&mid_bot_area,  lb_origo.x + CIRC_OCT4_X(cir),
@@ -769,22 +975,14 @@ static void lv_draw_rect_main_corner(const area_t * cords_p, const area_t * mask
         circ_next(&cir, &cir_tmp);
     }
 
-	mix = (uint32_t)((uint32_t)(cords_p->y2 - edge_top_area.y1)  * 255) / height;
-	act_color = color_mix(mcolor, gcolor, mix);
-	fill_fp(&edge_top_area, mask_p, act_color, opa);
+	lv_draw_rect_main_fill(&edge_top_area, mask_p, style_p, grad);
 if(edge_top_area.y1 != mid_top_area.y1) {
-		mix = (uint32_t)((uint32_t)(cords_p->y2 - mid_top_area.y1) * 255) / height;
-		act_color = color_mix(mcolor, gcolor, mix);
-		fill_fp(&mid_top_area, mask_p, act_color, opa);
+		lv_draw_rect_main_fill(&mid_top_area, mask_p, style_p, grad);
 	}
-	mix = (uint32_t)((uint32_t)(cords_p->y2 - mid_bot_area.y1) * 255) / height;
-	act_color = color_mix(mcolor, gcolor, mix);
-	fill_fp(&mid_bot_area, mask_p, act_color, opa);
+	lv_draw_rect_main_fill(&mid_bot_area, mask_p, style_p, grad);
 
 	if(edge_bot_area.y1 != mid_bot_area.y1) {
-		mix = (uint32_t)((uint32_t)(cords_p->y2 - edge_bot_area.y1) * 255) / height;
-		act_color = color_mix(mcolor, gcolor, mix);
-		fill_fp(&edge_bot_area, mask_p, act_color, opa);
+		lv_draw_rect_main_fill(&edge_bot_area, mask_p, style_p, grad);
 	}
 
 }
@@ -926,6 +1124,16 @@ static void lv_draw_rect_border_corner(const area_t * cords_p, const area_t * ma
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
+#if LV_CCACHE_SIZE != 0
+    /*Draw the rows of the corners from the cache*/
+    const lv_ccache_corner_t * corner = lv_ccache_get(radius, style->bwidth);
+    if(corner != NULL) {
+        lv_draw_rect_corner_cached(cords_p, mask_p, style, corner, NULL);
+        lv_ccache_release(corner);
+        return;
+    }
+#endif
+
     point_t lt_origo;   /*Left  Top    origo*/
     point_t lb_origo;   /*Left  Bottom origo*/
     point_t rt_origo;   /*Right Top    origo*/
@@ -1040,6 +1248,92 @@ static void lv_draw_rect_border_corner(const area_t * cords_p, const area_t * ma
     }
 }
 
+#if LV_CCACHE_SIZE != 0
+/**
+ * Draw the corners of a rectangle's body or border from a cached corner
+ * @param cords_p the coordinates of the original rectangle
+ * @param mask_p the corners will be drawn only on this area
+ * @param style pointer to a rectangle style
+ * @param corner the corner got with 'lv_ccache_get'
+ * @param grad the gradient of the body or NULL to use 'mcolor' (always NULL for the border)
+ */
+static void lv_draw_rect_corner_cached(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style,
+                                       const lv_ccache_corner_t * corner, const lv_grad_t * grad)
+{
+    cord_t radius = corner->radius;
+    bool body = corner->bwidth == 0 ? true : false;
+    color_t color = style->bcolor;
+    opa_t opa = (uint16_t)((uint16_t) style->opa * style->bopa) >> 8;
+
+    if(body != false) {
+        color = style->mcolor;
+        opa = style->opa;
+    }
+
+    /*Center of the left and right corners*/
+    cord_t x_left = cords_p->x1 + radius;
+    cord_t x_right = cords_p->x2 - radius;
+
+    area_t work_area;
+    const lv_ccache_row_t * row;
+    cord_t dy;
+    cord_t y;
+    uint8_t i;
+    for(dy = 0; dy <= radius; dy++) {
+        row = &corner->row_a[dy];
+        if(row->end < row->start) continue;
+
+        /*Draw the row to the top and to the bottom corners*/
+        for(i = 0; i < 2; i++) {
+            y = i == 0 ? cords_p->y1 + radius - dy : cords_p->y2 - radius + dy;
+            if(y < mask_p->y1 || y > mask_p->y2) continue;
+
+            work_area.y1 = y;
+            work_area.y2 = y;
+            if(row->full_start <= row->full_end) {
+                if(body != false && row->full_start == 0) {
+                    /*The body is filled from the left corner to the right one in one span*/
+                    work_area.x1 = x_left - row->full_end;
+                    work_area.x2 = x_right + row->full_end;
+                    lv_draw_rect_main_fill(&work_area, mask_p, style, grad);
+                } else {
+                    work_area.x1 = x_right + row->full_start;
+                    work_area.x2 = x_right + row->full_end;
+                    if(grad != NULL) grad_fill_fp(&work_area, mask_p, grad, opa);
+                    else fill_fp(&work_area, mask_p, color, opa);
+
+                    work_area.x1 = x_left - row->full_end;
+                    work_area.x2 = x_left - row->full_start;
+                    if(grad != NULL) grad_fill_fp(&work_area, mask_p, grad, opa);
+                    else fill_fp(&work_area, mask_p, color, opa);
+                }
+            }
+
+#if LV_EDGE_AA != 0
+            /*The partially covered pixels around the fully covered ones*/
+            const uint8_t * cov_a = &corner->cov_a[dy * (radius + 1)];
+            cord_t dx = row->start;
+            while(dx <= row->end) {
+                if(dx == row->full_start) {
+                    dx = row->full_end + 1;
+                    continue;
+                }
+
+                if(cov_a[dx] != 0) {
+                    if(grad != NULL) color = lv_grad_get_color(grad, x_right + dx, y);
+                    px_fp(x_right + dx, y, mask_p, color, ((uint16_t)opa * cov_a[dx]) >> 4);
+
+                    if(grad != NULL) color = lv_grad_get_color(grad, x_left - dx, y);
+                    px_fp(x_left - dx, y, mask_p, color, ((uint16_t)opa * cov_a[dx]) >> 4);
+                }
+                dx++;
+            }
+#endif
+        }
+    }
+}
+#endif
+
 /**
  * Draw a shadow
  * @param rect pointer to rectangle object
@@ -1082,6 +1376,16 @@ static void lv_draw_cont_shadow_full(const area_t * cords_p, const area_t * mask
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
+#if LV_SCACHE_SIZE != 0
+    /*Blend the blurred corners from the cache row by row*/
+    const lv_scache_shadow_t * shadow = lv_scache_get(radius, style->swidth, style->opa);
+    if(shadow != NULL) {
+        lv_draw_cont_shadow_full_cached(cords_p, mask_p, style, shadow);
+        lv_scache_release(shadow);
+        return;
+    }
+#endif
+
     cord_t cruve_x[LV_VER_RES] = {CORD_MIN};
     memset(cruve_x, 0, sizeof(cruve_x));
     point_t circ;
@@ -1213,6 +1517,53 @@ static void lv_draw_cont_shadow_full(const area_t * cords_p, const area_t * mask
 }
 
 
+#if LV_SCACHE_SIZE != 0
+/**
+ * Draw the corners and the straight parts of a full shadow from a cached shadow
+ * @param cords_p the coordinates of the rectangle
+ * @param mask_p the shadow will be drawn only in this mask
+ * @param style pointer to the style of the rectangle
+ * @param shadow the shadow got with 'lv_scache_get'
+ */
+static void lv_draw_cont_shadow_full_cached(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style,
+                                            const lv_scache_shadow_t * shadow)
+{
+    cord_t radius = shadow->radius;
+    point_t ofs_rt;
+    point_t ofs_lb;
+    ofs_rt.x = cords_p->x2 - radius;
+    ofs_rt.y = cords_p->y1 + radius;
+    ofs_lb.x = cords_p->x1 + radius;
+    ofs_lb.y = cords_p->y2 - radius;
+
+    uint16_t row;
+    for(row = 0; row < shadow->row_num; row++) {
+        const opa_t * opa_a = &shadow->opa_a[row * shadow->row_num];
+        uint16_t len = shadow->len[row];
+        cord_t r_x = ofs_rt.x + shadow->curve[row];
+        cord_t l_x = ofs_lb.x - shadow->curve[row];
+        cord_t t_y = ofs_rt.y - row;
+        cord_t b_y = ofs_lb.y + row;
+
+        /* On 1 px wide or high rectangles the corners can start on the same pixel.
+         * Draw these pixels only once.*/
+        uint16_t l_ofs = r_x == l_x ? 1 : 0;
+        bool b_en = t_y != b_y ? true : false;
+
+        px_row_fp(r_x, t_y, 1, mask_p, style->scolor, opa_a, len);
+        if(len > l_ofs) px_row_fp(l_x - l_ofs, t_y, -1, mask_p, style->scolor, opa_a + l_ofs, len - l_ofs);
+
+        if(b_en != false) {
+            px_row_fp(r_x, b_y, 1, mask_p, style->scolor, opa_a, len);
+            if(len > l_ofs) px_row_fp(l_x - l_ofs, b_y, -1, mask_p, style->scolor, opa_a + l_ofs, len - l_ofs);
+        }
+    }
+
+    /*The straight parts are the same as the first row of the corner*/
+    lv_draw_cont_shadow_full_straight(cords_p, mask_p, style, shadow->opa_a);
+}
+#endif
+
 static void lv_draw_cont_shadow_bottom(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style)
 {
     cord_t radius = style->radius;
@@ -1352,6 +1703,363 @@ static uint16_t lv_draw_cont_radius_corr(uint16_t r, cord_t w, cord_t h)
 	return r;
 }
 
+/**
+ * Draw the letters of a line of a text
+ * @param pos_p position of the first letter. Moved after the last letter.
+ * @param mask_p the letters will be drawn only in this area
+ * @param style pointer to a style
+ * @param txt 0 terminated text
+ * @param start index of the first letter of the line
+ * @param end index after the last letter of the line
+ * @param flag settings for the text from 'txt_flag_t' enum
+ */
+static void lv_draw_label_letters(point_t * pos_p, const area_t * mask_p, const lv_style_t * style,
+                                  const char * txt, uint32_t start, uint32_t end, txt_flag_t flag)
+{
+    const font_t * font = style->font;
+    cmd_state_t cmd_state = CMD_STATE_WAIT;
+    uint32_t i;
+    uint16_t par_start;
+    color_t recolor;
+
+    for(i = start; i < end; i++) {
+        /*Handle the re-color command*/
+        if((flag & TXT_FLAG_RECOLOR) != 0) {
+            if(txt[i] == TXT_RECOLOR_CMD) {
+                if(cmd_state == CMD_STATE_WAIT) { /*Start char*/
+                    par_start = i + 1;
+                    cmd_state = CMD_STATE_PAR;
+                    continue;
+                } else if(cmd_state == CMD_STATE_PAR) { /*Other start char in parameter escaped cmd. char */
+                    cmd_state = CMD_STATE_WAIT;
+                }else if(cmd_state == CMD_STATE_IN) { /*Command end */
+                    cmd_state = CMD_STATE_WAIT;
+                    continue;
+                }
+            }
+
+            /*Skip the color parameter and wait the space after it*/
+            if(cmd_state == CMD_STATE_PAR) {
+                if(txt[i] == ' ') {
+                    /*Get the parameter*/
+                    if(i - par_start == LABEL_RECOLOR_PAR_LENGTH) {
+                        char buf[LABEL_RECOLOR_PAR_LENGTH + 1];
+                        memcpy(buf, &txt[par_start], LABEL_RECOLOR_PAR_LENGTH);
+                        buf[LABEL_RECOLOR_PAR_LENGTH] = '\0';
+                        int r,g,b;
+                        sscanf(buf, "%02x%02x%02x", &r, &g, &b);
+                        recolor = COLOR_MAKE(r, g, b);
+                    } else {
+                        recolor.full = style->ccolor.full;
+                    }
+                    cmd_state = CMD_STATE_IN; /*After the parameter the text is in the command*/
+                }
+                continue;
+            }
+        }
+
+        color_t color = style->ccolor;
+
+        if(cmd_state == CMD_STATE_IN) color = recolor;
+        letter_fp(pos_p, mask_p, font, txt[i], color, style->opa);
+
+        pos_p->x += (font_get_width(font, txt[i]) >> FONT_ANTIALIAS) + style->letter_space;
+
+    }
+}
+
+#if LV_EDGE_AA != 0
+/**
+ * Draw the top and bottom parts (corners) of a rectangle with anti-aliased edges
+ * @param cords_p the coordinates of the original rectangle
+ * @param mask_p the rectangle will be drawn only  on this area
+ * @param style_p pointer to a rectangle style
+ * @param grad the gradient of the rectangle or NULL to fill with 'mcolor'
+ */
+static void lv_draw_rect_main_corner_aa(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p,
+                                        const lv_grad_t * grad)
+{
+    color_t mcolor = style_p->mcolor;
+    opa_t opa = style_p->opa;
+    cord_t height = area_get_height(cords_p);
+    cord_t width = area_get_width(cords_p);
+    cord_t radius = lv_draw_cont_radius_corr(style_p->radius, width, height);
+
+#if LV_CCACHE_SIZE != 0
+    /*Draw the rows of the corners from the cache*/
+    const lv_ccache_corner_t * corner = lv_ccache_get(radius, 0);
+    if(corner != NULL) {
+        lv_draw_rect_corner_cached(cords_p, mask_p, style_p, corner, grad);
+        lv_ccache_release(corner);
+        return;
+    }
+#endif
+
+    /*Center of the left and right corners and the top and bottom corners*/
+    cord_t x_left = cords_p->x1 + radius;
+    cord_t x_right = cords_p->x2 - radius;
+    cord_t y_top = cords_p->y1 + radius;
+    cord_t y_bottom = cords_p->y2 - radius;
+
+    /*The area between the left and right corners*/
+    area_t mid_area;
+    mid_area.x1 = x_left + 1;
+    mid_area.x2 = x_right - 1;
+
+    /*The rows of the centers are drawn by the body drawer*/
+    cord_t dy;
+    cord_t y;
+    for(dy = 1; dy <= radius; dy++) {
+        y = y_top - dy;
+        if(y >= mask_p->y1 && y <= mask_p->y2) {
+            lv_draw_aa_corner_row(x_left, y, -1, dy, radius, 0, mask_p, mcolor, grad, opa);
+            lv_draw_aa_corner_row(x_right, y, 1, dy, radius, 0, mask_p, mcolor, grad, opa);
+            if(mid_area.x1 <= mid_area.x2) {
+                mid_area.y1 = y;
+                mid_area.y2 = y;
+                lv_draw_rect_main_fill(&mid_area, mask_p, style_p, grad);
+            }
+        }
+
+        y = y_bottom + dy;
+        if(y >= mask_p->y1 && y <= mask_p->y2) {
+            lv_draw_aa_corner_row(x_left, y, -1, dy, radius, 0, mask_p, mcolor, grad, opa);
+            lv_draw_aa_corner_row(x_right, y, 1, dy, radius, 0, mask_p, mcolor, grad, opa);
+            if(mid_area.x1 <= mid_area.x2) {
+                mid_area.y1 = y;
+                mid_area.y2 = y;
+                lv_draw_rect_main_fill(&mid_area, mask_p, style_p, grad);
+            }
+        }
+    }
+}
+
+/**
+ * Draw the corners of a rectangle border with anti-aliased edges
+ * @param cords_p the coordinates of the original rectangle
+ * @param mask_p the rectangle will be drawn only  on this area
+ * @param style pointer to a rectangle style
+ */
+static void lv_draw_rect_border_corner_aa(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style)
+{
+    uint16_t bwidth = style->bwidth;
+    color_t bcolor = style->bcolor;
+    opa_t bopa = (uint16_t)((uint16_t) style->opa * style->bopa ) >> 8;
+    cord_t width = area_get_width(cords_p);
+    cord_t height = area_get_height(cords_p);
+    cord_t radius = lv_draw_cont_radius_corr(style->radius, width, height);
+
+#if LV_CCACHE_SIZE != 0
+    /*Draw the rows of the corners from the cache*/
+    const lv_ccache_corner_t * corner = lv_ccache_get(radius, style->bwidth);
+    if(corner != NULL) {
+        lv_draw_rect_corner_cached(cords_p, mask_p, style, corner, NULL);
+        lv_ccache_release(corner);
+        return;
+    }
+#endif
+
+    /*0 px border width drawn as 1 px, so decrement the bwidth*/
+    bwidth--;
+    cord_t radius_in = radius - bwidth;
+
+    cord_t x_left = cords_p->x1 + radius;
+    cord_t x_right = cords_p->x2 - radius;
+    cord_t y_top = cords_p->y1 + radius;
+    cord_t y_bottom = cords_p->y2 - radius;
+
+    /*The straight border parts start after the rows and columns of the centers*/
+    cord_t dy;
+    cord_t y;
+    for(dy = 0; dy <= radius; dy++) {
+        y = y_top - dy;
+        if(y >= mask_p->y1 && y <= mask_p->y2) {
+            lv_draw_aa_corner_row(x_left, y, -1, dy, radius, radius_in, mask_p, bcolor, NULL, bopa);
+            lv_draw_aa_corner_row(x_right, y, 1, dy, radius, radius_in, mask_p, bcolor, NULL, bopa);
+        }
+
+        y = y_bottom + dy;
+        if(y >= mask_p->y1 && y <= mask_p->y2) {
+            lv_draw_aa_corner_row(x_left, y, -1, dy, radius, radius_in, mask_p, bcolor, NULL, bopa);
+            lv_draw_aa_corner_row(x_right, y, 1, dy, radius, radius_in, mask_p, bcolor, NULL, bopa);
+        }
+    }
+}
+
+/**
+ * Draw a line with anti-aliased edges.
+ * The line is drawn column by column (or row by row if it is rather vertical)
+ * and the first and last pixels get opacity according to their coverage.
+ * @param p1 first point of the line
+ * @param p2 second point of the line
+ * @param mask_p the line will be drawn only on this area
+ * @param style pointer to a line style
+ */
+static void lv_draw_line_aa(const point_t * p1, const point_t * p2, const area_t * mask_p, const lv_style_t * style)
+{
+    bool hor = MATH_ABS(p2->x - p1->x) >= MATH_ABS(p2->y - p1->y) ? true : false;
+
+    /*'u' goes along the line (x if horizontal) and 'v' across it*/
+    int32_t u1 = hor ? p1->x : p1->y;
+    int32_t v1 = hor ? p1->y : p1->x;
+    int32_t du = hor ? p2->x - p1->x : p2->y - p1->y;
+    int32_t dv = hor ? p2->y - p1->y : p2->x - p1->x;
+
+    /*Always go to the positive direction*/
+    if(du < 0) {
+        u1 += du;
+        v1 += dv;
+        du = -du;
+        dv = -dv;
+    }
+
+    /*Width across the line in 1/256 px: line_width / cos(angle)*/
+    uint32_t len16 = lv_draw_aa_sqrt((uint32_t)(du * du + dv * dv) << 8);
+    int32_t width8 = ((int32_t)style->line_width * (int32_t)len16 * 16) / du;
+
+    color_t color = style->ccolor;
+    opa_t opa = style->opa;
+    area_t span_area;
+    int32_t u;
+    for(u = u1; u <= u1 + du; u++) {
+        /*The edges of the line in this column in 1/256 px*/
+        int32_t center8 = v1 * 256 + ((u - u1) * dv * 256) / du;
+        int32_t v1_8 = center8 - width8 / 2;
+        int32_t v2_8 = center8 + width8 / 2;
+        cord_t v_first = (v1_8 + 128) >> 8;
+        cord_t v_last = (v2_8 + 128) >> 8;
+        opa_t opa_first;
+        opa_t opa_last;
+
+        if(v_first == v_last) {
+            opa_first = ((uint32_t)opa * (v2_8 - v1_8)) >> 8;
+            if(hor) px_fp(u, v_first, mask_p, color, opa_first);
+            else px_fp(v_first, u, mask_p, color, opa_first);
+            continue;
+        }
+
+        /*The covered part of the first and last pixels*/
+        opa_first = ((uint32_t)opa * (((int32_t)v_first << 8) + 128 - v1_8)) >> 8;
+        opa_last = ((uint32_t)opa * (v2_8 - ((int32_t)v_last << 8) + 128)) >> 8;
+
+        if(hor) {
+            px_fp(u, v_first, mask_p, color, opa_first);
+            px_fp(u, v_last, mask_p, color, opa_last);
+            area_set(&span_area, u, v_first + 1, u, v_last - 1);
+        } else {
+            px_fp(v_first, u, mask_p, color, opa_first);
+            px_fp(v_last, u, mask_p, color, opa_last);
+            area_set(&span_area, v_first + 1, u, v_last - 1, u);
+        }
+
+        if(v_last - v_first > 1) fill_fp(&span_area, mask_p, color, opa);
+    }
+}
+
+/**
+ * Draw a row of an anti-aliased quarter circle or quarter ring.
+ * The pixels get opacity according to their distance from the edges.
+ * @param ox x coordinate of the center
+ * @param y the row to draw
+ * @param dir 1: draw on the right of 'ox', -1: draw on the left of 'ox'
+ * @param dy distance of 'y' from the center
+ * @param r_out radius of the outer edge
+ * @param r_in radius of the inner edge (<= 0 to draw a full quarter circle)
+ * @param mask_p draw only on this area
+ * @param color color of the row
+ * @param grad gradient of the row or NULL to use 'color'
+ * @param opa opacity of the fully covered pixels
+ */
+static void lv_draw_aa_corner_row(cord_t ox, cord_t y, int8_t dir, cord_t dy, cord_t r_out, cord_t r_in,
+                                  const area_t * mask_p, color_t color, const lv_grad_t * grad, opa_t opa)
+{
+    cord_t dx = 0;
+    cord_t full_end;
+    uint32_t d16;       /*Distance of a pixel from the center * 16*/
+    int32_t cov_out;    /*Coverage of a pixel by the outer circle (0..16)*/
+    int32_t cov_in;     /*Coverage of a pixel by the outside of the inner circle (0..16)*/
+    area_t full_area;
+
+    /* The edges are on the outer side of the pixels at 'r_out' and 'r_in' distance
+     * to join the straight parts (which fully cover these pixels)*/
+
+    /*Skip the pixels which are fully inside the inner circle*/
+    if(r_in > 0) dx = lv_draw_aa_span(2 * r_in - 2, dy) + 1;
+
+    while(dx <= r_out) {
+        d16 = lv_draw_aa_sqrt((uint32_t)(dx * dx + dy * dy) << 8);
+        cov_out = (int32_t)r_out * 16 + 16 - (int32_t)d16;
+        if(cov_out <= 0) break;                 /*Out of the outer circle*/
+        if(cov_out > 16) cov_out = 16;
+
+        cov_in = 16;
+        if(r_in > 0) {
+            cov_in = (int32_t)d16 - ((int32_t)r_in * 16 - 16);
+            if(cov_in < 0) cov_in = 0;
+            if(cov_in > 16) cov_in = 16;
+        }
+
+        if(cov_out == 16 && cov_in == 16) {
+            /*Fill the fully covered pixels together*/
+            full_end = lv_draw_aa_span(2 * r_out, dy);
+            if(full_end < dx) full_end = dx;
+
+            if(dir > 0) area_set(&full_area, ox + dx, y, ox + full_end, y);
+            else area_set(&full_area, ox - full_end, y, ox - dx, y);
+            if(grad != NULL) grad_fill_fp(&full_area, mask_p, grad, opa);
+            else fill_fp(&full_area, mask_p, color, opa);
+            dx = full_end + 1;
+        } else {
+            if(cov_in < cov_out) cov_out = cov_in;
+            if(cov_out != 0) {
+                if(grad != NULL) color = lv_grad_get_color(grad, ox + dir * dx, y);
+                px_fp(ox + dir * dx, y, mask_p, color, ((uint16_t)opa * cov_out) >> 4);
+            }
+            dx++;
+        }
+    }
+}
+
+/**
+ * Get the last pixel in a row which is in a circle
+ * @param d2 diameter of the circle (2 * radius)
+ * @param dy distance of the row from the center
+ * @return the last 'dx' distance in the circle (-1 if the row is out of the circle)
+ */
+static cord_t lv_draw_aa_span(int32_t d2, cord_t dy)
+{
+    /* (2 * dx)^2 + (2 * dy)^2 <= d2^2*/
+    int32_t v = d2 * d2 - 4 * (int32_t)dy * dy;
+    if(d2 < 0 || v < 0) return -1;
+
+    return lv_draw_aa_sqrt(v >> 2);
+}
+
+/**
+ * Integer square root
+ * @param x a number
+ * @return the square root of 'x' rounded down
+ */
+static uint32_t lv_draw_aa_sqrt(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = (uint32_t)1 << 30;
+
+    while(bit > x) bit >>= 2;
+
+    while(bit != 0) {
+        if(x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return res;
+}
+#endif /*LV_EDGE_AA != 0*/
 
 #if USE_LV_TRIANGLE != 0
 /**
@@ -25,6 +25,13 @@ extern "C" {
  *      TYPEDEFS
  **********************/ 
 
+/*A line of a text with pre-calculated break position (see 'lv_draw_label_lines')*/
+typedef struct
+{
+    uint16_t start;     /*Index of the first letter of the line*/
+    cord_t w;           /*Width of the line*/
+}lv_draw_label_line_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -37,6 +44,15 @@ extern "C" {
  */
 void lv_draw_rect(const area_t * cords_p, const area_t * mask_p, const lv_style_t * style_p);
 
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+/**
+ * Prepare the cached data of a rectangle (e.g. its shadow) before drawing it on more threads
+ * @param cords_p the coordinates of the rectangle
+ * @param style_p pointer to a style
+ */
+void lv_draw_rect_prepare(const area_t * cords_p, const lv_style_t * style_p);
+#endif
+
 
 /*Experimental use for 3D modeling*/
 #define USE_LV_TRIANGLE 0
@@ -62,6 +78,21 @@ void lv_draw_triangle(const point_t * points, const area_t * mask_p, color_t col
 void lv_draw_label(const area_t * cords_p,const area_t * mask_p, const lv_style_t * style_p,
                     const char * txt, txt_flag_t flag, point_t * offset);
 
+/**
+ * Write a text with pre-calculated line breaks (e.g. cached by the object)
+ * @param cords_p coordinates of the label
+ * @param mask_p the label will be drawn only in this area
+ * @param style_p pointer to a style
+ * @param txt 0 terminated text to write
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @param offset text offset in x and y direction (NULL if unused)
+ * @param lines array of the lines. 'lines[line_num].start' has to be the end of the last line.
+ * @param line_num number of lines
+ */
+void lv_draw_label_lines(const area_t * cords_p,const area_t * mask_p, const lv_style_t * style_p,
+                         const char * txt, txt_flag_t flag, point_t * offset,
+                         const lv_draw_label_line_t * lines, uint16_t line_num);
+
 /**
  * Draw an image
  * @param cords_p the coordinates of the image
@@ -54,6 +54,30 @@ void lv_rpx(cord_t x, cord_t y, const area_t * mask_p, color_t color, opa_t opa)
     lv_rfill(&area, mask_p, color, OPA_COVER);
 }
 
+/**
+ * Put a horizontal row of pixels to the display
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the row
+ * @param dir 1: the next pixels are on the right, -1: on the left
+ * @param mask_p the row will be drawn only on this area
+ * @param color color of the pixels
+ * @param opa_a opacity of the pixels (ignored, only for compatibility with lv_vpx_row)
+ * @param len number of pixels
+ */
+void lv_rpx_row(cord_t x, cord_t y, int8_t dir, const area_t * mask_p,
+                color_t color, const opa_t * opa_a, uint16_t len)
+{
+    if(len == 0) return;
+
+    area_t area;
+    area.x1 = dir > 0 ? x : x - len + 1;
+    area.y1 = y;
+    area.x2 = dir > 0 ? x + len - 1 : x;
+    area.y2 = y;
+
+    lv_rfill(&area, mask_p, color, OPA_COVER);
+}
+
 /**
  * Fill an area on the display
  * @param cords_p coordinates of the area to fill
@@ -81,6 +105,38 @@ void lv_rfill(const area_t * cords_p, const area_t * mask_p,
     }
 }
 
+/**
+ * Fill an area on the display with the colors of a gradient
+ * @param cords_p coordinates of the area to fill (a part of the gradient's rectangle)
+ * @param mask_p fill only on this mask
+ * @param grad pointer to a gradient got with 'lv_grad_get'
+ * @param opa opacity (ignored, only for compatibility with lv_vfill_grad)
+ */
+void lv_rfill_grad(const area_t * cords_p, const area_t * mask_p,
+                   const lv_grad_t * grad, opa_t opa)
+{
+    area_t masked_area;
+    if(area_union(&masked_area, cords_p, mask_p) == false) return;
+
+    /*Fill the rows (or columns) with their color one by one*/
+    area_t line_area;
+    area_cpy(&line_area, &masked_area);
+    cord_t i;
+    if(grad->dir == LV_GDIR_HOR) {
+        for(i = masked_area.x1; i <= masked_area.x2; i++) {
+            line_area.x1 = i;
+            line_area.x2 = i;
+            lv_rfill(&line_area, NULL, lv_grad_get_color(grad, i, masked_area.y1), opa);
+        }
+    } else {
+        for(i = masked_area.y1; i <= masked_area.y2; i++) {
+            line_area.y1 = i;
+            line_area.y2 = i;
+            lv_rfill(&line_area, NULL, lv_grad_get_color(grad, masked_area.x1, i), opa);
+        }
+    }
+}
+
 /**
  * Draw a letter to the display
  * @param pos_p left-top coordinate of the latter
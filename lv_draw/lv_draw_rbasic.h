@@ -16,6 +16,7 @@ extern "C" {
 #include "misc/gfx/color.h"
 #include "misc/gfx/area.h"
 #include "misc/gfx/font.h"
+#include "lv_grad.h"
 
 /*********************
  *      DEFINES
@@ -31,6 +32,19 @@ extern "C" {
 
 void lv_rpx(cord_t x, cord_t y, const area_t * mask_p, color_t color, opa_t opa);
 
+/**
+ * Put a horizontal row of pixels to the display
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the row
+ * @param dir 1: the next pixels are on the right, -1: on the left
+ * @param mask_p the row will be drawn only on this area
+ * @param color color of the pixels
+ * @param opa_a opacity of the pixels (ignored, only for compatibility with lv_vpx_row)
+ * @param len number of pixels
+ */
+void lv_rpx_row(cord_t x, cord_t y, int8_t dir, const area_t * mask_p,
+                color_t color, const opa_t * opa_a, uint16_t len);
+
 /**
  * Fill an area on the display
  * @param cords_p coordinates of the area to fill
@@ -41,6 +55,16 @@ void lv_rpx(cord_t x, cord_t y, const area_t * mask_p, color_t color, opa_t opa)
 void lv_rfill(const area_t * cords_p, const area_t * mask_p,
                 color_t color, opa_t opa);
 
+/**
+ * Fill an area on the display with the colors of a gradient
+ * @param cords_p coordinates of the area to fill (a part of the gradient's rectangle)
+ * @param mask_p fill only on this mask
+ * @param grad pointer to a gradient got with 'lv_grad_get'
+ * @param opa opacity (ignored, only for compatibility with lv_vfill_grad)
+ */
+void lv_rfill_grad(const area_t * cords_p, const area_t * mask_p,
+                   const lv_grad_t * grad, opa_t opa);
+
 /**
  * Draw a letter to the display
  * @param pos_p left-top coordinate of the latter
@@ -16,6 +16,8 @@
 
 #include <stddef.h>
 #include "lvgl/lv_obj/lv_vdb.h"
+#include "lv_gcache.h"
+#include "lv_grad.h"
 
 /*********************
  *      INCLUDES
@@ -29,15 +31,47 @@
  *      TYPEDEFS
  **********************/
 
+/*A color prepared to be mixed with many background pixels.
+ * With 16 and 24 bit color depth the channels are handled together in 32 bit words*/
+typedef struct
+{
+#if COLOR_DEPTH == 16 || COLOR_DEPTH == 24
+    uint32_t rb;        /*Red and blue channels of the color multiplied with 'opa'*/
+    uint32_t g;         /*Green channel of the color multiplied with 'opa'*/
+    uint32_t rest;      /*Bits of the color which are not mixed*/
+    uint16_t opa_inv;   /*255 - opa*/
+#else
+    color_t color;
+    opa_t opa;
+#endif
+}sw_mix_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void sw_color_cpy(color_t * dest, const color_t * src, uint32_t length, opa_t opa);
 static void sw_color_fill(area_t * mem_area, color_t * mem, const area_t * fill_area, color_t color, opa_t opa);
+static void sw_grad_fill(area_t * mem_area, color_t * mem, const area_t * fill_area, const lv_grad_t * grad, opa_t opa);
+static inline void sw_mix_init(sw_mix_t * mix, color_t color, opa_t opa);
+static inline color_t sw_mix_px(const sw_mix_t * mix, color_t bg);
+static inline color_t sw_color_mix(color_t c1, color_t c2, opa_t opa);
+#if LV_GCACHE_SIZE != 0
+static void sw_letter_blend(const point_t * pos_p, const area_t * mask_p,
+                            const lv_gcache_glyph_t * glyph, color_t color, opa_t opa);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_GRAD_DITHER != 0 && DISP_HW_ACC == 0
+/*Ordered dithering thresholds of the gradients (the 4 fractional bits)*/
+static const uint8_t grad_dith_th[4][4] = {
+        { 0,  8,  2, 10},
+        {12,  4, 14,  6},
+        { 3, 11,  1,  9},
+        {15,  7, 13,  5}
+};
+#endif
 
 /**********************
  *      MACROS
@@ -82,6 +116,52 @@ void lv_vpx(cord_t x, cord_t y, const area_t * mask_p, color_t color, opa_t opa)
 }
 
 
+/**
+ * Put a horizontal row of pixels with the same color but different opacity in the Virtual Display Buffer
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the row
+ * @param dir 1: the next pixels are on the right, -1: on the left
+ * @param mask_p the row will be drawn only on this area (truncated to VDB area)
+ * @param color color of the pixels
+ * @param opa_a opacity of the pixels (0..255)
+ * @param len number of pixels
+ */
+void lv_vpx_row(cord_t x, cord_t y, int8_t dir, const area_t * mask_p,
+                color_t color, const opa_t * opa_a, uint16_t len)
+{
+    if(len == 0 || y < mask_p->y1 || y > mask_p->y2) return;
+
+    /*Truncate the row to the mask*/
+    cord_t x1 = dir > 0 ? x : x - len + 1;
+    cord_t x2 = dir > 0 ? x + len - 1 : x;
+    if(x1 < mask_p->x1) x1 = mask_p->x1;
+    if(x2 > mask_p->x2) x2 = mask_p->x2;
+    if(x1 > x2) return;
+
+    lv_vdb_t * vdb_p = lv_vdb_get();
+    uint32_t vdb_width = area_get_width(&vdb_p->area);
+    color_t * vdb_px_p = vdb_p->buf + (y - vdb_p->area.y1) * vdb_width + (x1 - vdb_p->area.x1);
+
+    /*Go from left to right in the VDB and step in the opacities according to the direction*/
+    const opa_t * opa_p = opa_a + (x1 - x) * dir;
+    sw_mix_t mix;
+    opa_t opa_last = OPA_COVER;
+    cord_t col;
+    for(col = x1; col <= x2; col++) {
+        if(*opa_p == OPA_COVER) {
+            *vdb_px_p = color;
+        } else {
+            if(*opa_p != opa_last) {
+                opa_last = *opa_p;
+                sw_mix_init(&mix, color, opa_last);
+            }
+            *vdb_px_p = sw_mix_px(&mix, *vdb_px_p);
+        }
+        vdb_px_p ++;
+        opa_p += dir;
+    }
+}
+
 /**
  * Fill an area in the Virtual Display Buffer
  * @param cords_p coordinates of the area to fill
@@ -140,6 +220,54 @@ void lv_vfill(const area_t * cords_p, const area_t * mask_p,
 
 }
 
+/**
+ * Fill an area in the Virtual Display Buffer with the colors of a gradient
+ * @param cords_p coordinates of the area to fill (a part of the gradient's rectangle)
+ * @param mask_p fill only on this mask (truncated to VDB area)
+ * @param grad pointer to a gradient got with 'lv_grad_get'
+ * @param opa opacity of the area (0..255)
+ */
+void lv_vfill_grad(const area_t * cords_p, const area_t * mask_p,
+                   const lv_grad_t * grad, opa_t opa)
+{
+    area_t res_a;
+    lv_vdb_t * vdb_p = lv_vdb_get();
+
+    /*Get the union of cord and mask*/
+    if(area_union(&res_a, cords_p, mask_p) == false) return;
+
+#if DISP_HW_ACC == 0
+    area_t vdb_rel_a;   /*Stores relative coordinates on vdb*/
+    vdb_rel_a.x1 = res_a.x1 - vdb_p->area.x1;
+    vdb_rel_a.y1 = res_a.y1 - vdb_p->area.y1;
+    vdb_rel_a.x2 = res_a.x2 - vdb_p->area.x1;
+    vdb_rel_a.y2 = res_a.y2 - vdb_p->area.y1;
+
+    /*Move the vdb_tmp to the first row*/
+    color_t * vdb_buf_tmp = vdb_p->buf + area_get_width(&vdb_p->area) * vdb_rel_a.y1;
+
+    sw_grad_fill(&vdb_p->area, vdb_buf_tmp, &vdb_rel_a, grad, opa);
+#else
+    /*Fill the rows (or columns) with their color one by one*/
+    area_t line_area;
+    area_cpy(&line_area, &res_a);
+    cord_t i;
+    if(grad->dir == LV_GDIR_HOR) {
+        for(i = res_a.x1; i <= res_a.x2; i++) {
+            line_area.x1 = i;
+            line_area.x2 = i;
+            lv_vfill(&line_area, mask_p, lv_grad_get_color(grad, i, res_a.y1), opa);
+        }
+    } else {
+        for(i = res_a.y1; i <= res_a.y2; i++) {
+            line_area.y1 = i;
+            line_area.y2 = i;
+            lv_vfill(&line_area, mask_p, lv_grad_get_color(grad, res_a.x1, i), opa);
+        }
+    }
+#endif
+}
+
 /**
  * Draw a letter in the Virtual Display Buffer
  * @param pos_p left-top coordinate of the latter
@@ -155,6 +283,16 @@ void lv_vletter(const point_t * pos_p, const area_t * mask_p,
 {      
     if(font_p == NULL) return;
 
+#if LV_GCACHE_SIZE != 0
+    /*Blend the pre-decoded alpha mask if the letter could be cached*/
+    const lv_gcache_glyph_t * glyph = lv_gcache_get(font_p, letter);
+    if(glyph != NULL) {
+        sw_letter_blend(pos_p, mask_p, glyph, color, opa);
+        lv_gcache_release(glyph);
+        return;
+    }
+#endif
+
     uint8_t letter_w = font_get_width(font_p, letter);
     uint8_t letter_h = font_get_height(font_p);
 
@@ -193,6 +331,14 @@ void lv_vletter(const point_t * pos_p, const area_t * mask_p,
 #if FONT_ANTIALIAS != 0
     opa_t opa_tmp = opa;
     if(opa_tmp != OPA_COVER) opa_tmp = opa_tmp >> 2;   /*Opacity per pixel (used when sum the pixels)*/
+    else opa_tmp = 63;
+
+    /*Prepare the color for the 1..4 covered sub-pixels*/
+    sw_mix_t mix[4];
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        sw_mix_init(&mix[i], color, opa_tmp * (i + 1));
+    }
     const uint8_t * map1_p = map_p;
     const uint8_t * map2_p = map_p + font_p->width_byte;
     uint8_t px_cnt;
@@ -223,8 +369,7 @@ void lv_vletter(const point_t * pos_p, const area_t * mask_p,
 
 
             if(px_cnt != 0) {
-                if(opa == OPA_COVER) *vdb_buf_tmp = color_mix(color, *vdb_buf_tmp, 63*px_cnt);
-                else *vdb_buf_tmp = color_mix(color, *vdb_buf_tmp, opa_tmp * px_cnt);
+                *vdb_buf_tmp = sw_mix_px(&mix[px_cnt - 1], *vdb_buf_tmp);
             }
 
            vdb_buf_tmp++;
@@ -237,6 +382,8 @@ void lv_vletter(const point_t * pos_p, const area_t * mask_p,
         vdb_buf_tmp += vdb_width  - ((col_end) - (col_start)); /*Next row in VDB*/
     }
 #else
+    sw_mix_t mix;
+    sw_mix_init(&mix, color, opa);
     for(row = row_start; row < row_end; row ++) {
         col_byte_cnt = 0;
         col_bit = 7 - (col_start % 8);
@@ -244,7 +391,7 @@ void lv_vletter(const point_t * pos_p, const area_t * mask_p,
 
             if((*map_p & (1 << col_bit)) != 0) {
                 if(opa == OPA_COVER) *vdb_buf_tmp = color;
-                else *vdb_buf_tmp = color_mix(color, *vdb_buf_tmp, opa);
+                else *vdb_buf_tmp = sw_mix_px(&mix, *vdb_buf_tmp);
             }
 
            vdb_buf_tmp++;
@@ -354,7 +501,7 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
                     for(row = masked_a.y1; row <= masked_a.y2; row++) {
                         for(col = masked_a.x1; col <= masked_a.x2; col ++) {
                             if(map_p[col].full != transp_color.full) {
-                                vdb_buf_tmp[col] = color_mix( map_p[col], vdb_buf_tmp[col], opa);
+                                vdb_buf_tmp[col] = sw_color_mix(map_p[col], vdb_buf_tmp[col], opa);
                             }
                         }
 
@@ -364,11 +511,13 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
                 }
             } else { /*Recolor needed*/
                 color_t color_tmp;
+                sw_mix_t recolor_mix;
+                sw_mix_init(&recolor_mix, recolor, recolor_opa);
                 if(opa == OPA_COVER)  { /*no opa */
                     for(row = masked_a.y1; row <= masked_a.y2; row++) {
                         for(col = masked_a.x1; col <= masked_a.x2; col ++) {
                             if(map_p[col].full != transp_color.full) {
-                                color_tmp = color_mix(recolor, map_p[col], recolor_opa);
+                                color_tmp = sw_mix_px(&recolor_mix, map_p[col]);
                                 vdb_buf_tmp[col] = color_tmp;
                             }
                         }
@@ -380,8 +529,8 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
                     for(row = masked_a.y1; row <= masked_a.y2; row++) {
                         for(col = masked_a.x1; col <= masked_a.x2; col ++) {
                             if(map_p[col].full != transp_color.full) {
-                                color_tmp = color_mix(recolor, map_p[col], recolor_opa);
-                                vdb_buf_tmp[col] = color_mix(color_tmp, vdb_buf_tmp[col], opa);
+                                color_tmp = sw_mix_px(&recolor_mix, map_p[col]);
+                                vdb_buf_tmp[col] = sw_color_mix(color_tmp, vdb_buf_tmp[col], opa);
                             }
                         }
 
@@ -426,7 +575,9 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
         }
         /*Handle other cases*/
         else {
-           color_tmp = color_mix(recolor, prev_color, recolor_opa);
+           sw_mix_t recolor_mix;
+           sw_mix_init(&recolor_mix, recolor, recolor_opa);
+           color_tmp = sw_mix_px(&recolor_mix, prev_color);
            for(row = masked_a.y1; row <= masked_a.y2; row++) {
                for(col = masked_a.x1; col <= masked_a.x2; col ++) {
                    map_col = col >> 1;
@@ -437,7 +588,7 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
                    } else {
                        if(map_p[map_col].full != prev_color.full) {
                            prev_color.full = map_p[map_col].full;
-                           color_tmp = color_mix(recolor, prev_color, recolor_opa);
+                           color_tmp = sw_mix_px(&recolor_mix, prev_color);
                        }
                    }
                    /*Put the NOT transparent pixels*/
@@ -446,7 +597,7 @@ void lv_vmap(const area_t * cords_p, const area_t * mask_p,
                        if(opa == OPA_COVER) {
                            vdb_buf_tmp[col] = color_tmp;
                        } else {
-                           vdb_buf_tmp[col] = color_mix( color_tmp, vdb_buf_tmp[col], opa);
+                           vdb_buf_tmp[col] = sw_color_mix(color_tmp, vdb_buf_tmp[col], opa);
                        }
                    }
                }
@@ -475,10 +626,10 @@ static void sw_color_cpy(color_t * dest, const color_t * src, uint32_t length, o
     if(opa == OPA_COVER) {
         memcpy(dest, src, length * sizeof(color_t));
     } else {
-        cord_t col;
+        uint32_t col;
         for(col = 0; col < length; col++) {
-        	dest[col] = color_mix(src[col], dest[col], opa);
-		}
+            dest[col] = sw_color_mix(src[col], dest[col], opa);
+        }
     }
 }
 
@@ -515,14 +666,16 @@ static void sw_color_fill(area_t * mem_area, color_t * mem, const area_t * fill_
     }
     /*Calculate with alpha too*/
     else {
+        sw_mix_t mix;
+        sw_mix_init(&mix, color, opa);
         color_t bg_tmp = COLOR_BLACK;
-        color_t opa_tmp = color_mix(color, bg_tmp, opa);
+        color_t opa_tmp = sw_mix_px(&mix, bg_tmp);
         for(row = fill_area->y1; row <= fill_area->y2; row++) {
             for(col = fill_area->x1; col <= fill_area->x2; col++) {
                 /*If the bg color changed recalculate the result color*/
                 if(mem[col].full != bg_tmp.full) {
                     bg_tmp = mem[col];
-                    opa_tmp = color_mix(color, bg_tmp, opa);
+                    opa_tmp = sw_mix_px(&mix, bg_tmp);
                 }
                 mem[col] = opa_tmp;
             }
@@ -530,6 +683,205 @@ static void sw_color_fill(area_t * mem_area, color_t * mem, const area_t * fill_
         }
     }
 }
+
+/**
+ * Fill an area with the colors of a gradient in one pass
+ * @param mem_area coordinates of 'mem' memory area
+ * @param mem a memory address. Considered to a rectangual window according to 'mem_area'
+ * @param fill_area coordinates of an area to fill. Relative to 'mem_area'.
+ * @param grad pointer to a gradient
+ * @param opa opacity (0, OPA_TRANSP: transparent ... 255, OPA_COVER, fully cover)
+ */
+static void sw_grad_fill(area_t * mem_area, color_t * mem, const area_t * fill_area, const lv_grad_t * grad, opa_t opa)
+{
+    cord_t row;
+    cord_t col;
+    cord_t mem_width = area_get_width(mem_area);
+
+    /*The gradient's index of the first row and column*/
+    int32_t row_ofs = mem_area->y1 - grad->ofs;
+    int32_t col_ofs = mem_area->x1 - grad->ofs;
+
+#if LV_GRAD_DITHER != 0
+    /*Round the channels up or down according to the position of the pixel*/
+    const lv_grad_dith_t * dith;
+    const uint8_t * th_row;
+    color_t color;
+    for(row = fill_area->y1; row <= fill_area->y2; row++) {
+        th_row = grad_dith_th[(row + mem_area->y1) & 0x3];
+        dith = grad->dir == LV_GDIR_HOR ? &grad->dith_a[fill_area->x1 + col_ofs] : &grad->dith_a[row + row_ofs];
+        for(col = fill_area->x1; col <= fill_area->x2; col++) {
+            uint8_t th = th_row[(col + mem_area->x1) & 0x3];
+            color.red = (dith->red + th) >> 4;
+            color.green = (dith->green + th) >> 4;
+            color.blue = (dith->blue + th) >> 4;
+
+            if(opa == OPA_COVER) mem[col] = color;
+            else mem[col] = sw_color_mix(color, mem[col], opa);
+
+            if(grad->dir == LV_GDIR_HOR) dith++;
+        }
+        mem += mem_width;
+    }
+#else
+    if(grad->dir == LV_GDIR_HOR) {
+        /*Every row is the same part of the gradient*/
+        const color_t * color_first = &grad->color_a[fill_area->x1 + col_ofs];
+        uint32_t length = fill_area->x2 - fill_area->x1 + 1;
+        for(row = fill_area->y1; row <= fill_area->y2; row++) {
+            sw_color_cpy(&mem[fill_area->x1], color_first, length, opa);
+            mem += mem_width;
+        }
+    } else {
+        /*Fill every row with its color*/
+        const color_t * color_p = &grad->color_a[fill_area->y1 + row_ofs];
+        sw_mix_t mix;
+        for(row = fill_area->y1; row <= fill_area->y2; row++) {
+            if(opa == OPA_COVER) {
+                for(col = fill_area->x1; col <= fill_area->x2; col++) {
+                    mem[col] = *color_p;
+                }
+            } else {
+                sw_mix_init(&mix, *color_p, opa);
+                for(col = fill_area->x1; col <= fill_area->x2; col++) {
+                    mem[col] = sw_mix_px(&mix, mem[col]);
+                }
+            }
+            color_p++;
+            mem += mem_width;
+        }
+    }
+#endif
+}
 #endif /*DISP_HW_ACC == 0*/
 
+/**
+ * Prepare a color to mix it with many pixels. Gives the same result as 'color_mix()'
+ * but with 16 and 24 bit color depth the color channels are calculated together.
+ * @param mix pointer to a 'sw_mix_t' variable to initialize
+ * @param color the color to mix (the foreground)
+ * @param opa opacity of 'color'
+ */
+static inline void sw_mix_init(sw_mix_t * mix, color_t color, opa_t opa)
+{
+#if COLOR_DEPTH == 16
+    /*Move the red channel to the upper half-word to leave space for the products*/
+    mix->rb = ((color.full & 0x001F) | ((uint32_t)(color.full & 0xF800) << 5)) * opa;
+    mix->g = (uint32_t)(color.full & 0x07E0) * opa;
+    mix->rest = 0;
+    mix->opa_inv = 255 - opa;
+#elif COLOR_DEPTH == 24
+    mix->rb = (color.full & 0x00FF00FF) * opa;
+    mix->g = (color.full & 0x0000FF00) * opa;
+    mix->rest = color.full & 0xFF000000;
+    mix->opa_inv = 255 - opa;
+#else
+    mix->color = color;
+    mix->opa = opa;
+#endif
+}
+
+/**
+ * Mix a prepared color with a pixel
+ * @param mix pointer to a color prepared by 'sw_mix_init()'
+ * @param bg the background pixel
+ * @return the mixed color
+ */
+static inline color_t sw_mix_px(const sw_mix_t * mix, color_t bg)
+{
+#if COLOR_DEPTH == 16
+    color_t ret;
+    uint32_t rb = ((bg.full & 0x001F) | ((uint32_t)(bg.full & 0xF800) << 5)) * mix->opa_inv + mix->rb;
+    uint32_t g = (uint32_t)(bg.full & 0x07E0) * mix->opa_inv + mix->g;
+    rb = (rb >> 8) & 0x001F001F;
+    ret.full = (rb & 0x001F) | ((rb >> 5) & 0xF800) | ((g >> 8) & 0x07E0);
+    return ret;
+#elif COLOR_DEPTH == 24
+    color_t ret;
+    uint32_t rb = (bg.full & 0x00FF00FF) * mix->opa_inv + mix->rb;
+    uint32_t g = (bg.full & 0x0000FF00) * mix->opa_inv + mix->g;
+    ret.full = mix->rest | ((rb >> 8) & 0x00FF00FF) | ((g >> 8) & 0x0000FF00);
+    return ret;
+#else
+    return color_mix(mix->color, bg, mix->opa);
+#endif
+}
+
+/**
+ * Mix two colors. Same as 'color_mix()' but faster with 16 and 24 bit color depth.
+ * @param c1 the first color (the foreground)
+ * @param c2 the second color (the background)
+ * @param opa opacity of 'c1'
+ * @return the mixed color
+ */
+static inline color_t sw_color_mix(color_t c1, color_t c2, opa_t opa)
+{
+    sw_mix_t mix;
+    sw_mix_init(&mix, c1, opa);
+    return sw_mix_px(&mix, c2);
+}
+
+#if LV_GCACHE_SIZE != 0
+/**
+ * Blend a cached letter into the VDB
+ * @param pos_p left-top coordinate of the latter
+ * @param mask_p the letter will be drawn only on this area (truncated to VDB area)
+ * @param glyph pointer to the cached letter
+ * @param color color of letter
+ * @param opa opacity of letter (0..255)
+ */
+static void sw_letter_blend(const point_t * pos_p, const area_t * mask_p,
+                            const lv_gcache_glyph_t * glyph, color_t color, opa_t opa)
+{
+    area_t letter_area;
+    area_t masked_a;
+    letter_area.x1 = pos_p->x;
+    letter_area.y1 = pos_p->y;
+    letter_area.x2 = pos_p->x + glyph->w - 1;
+    letter_area.y2 = pos_p->y + glyph->h - 1;
+
+    if(glyph->mask == NULL) return;     /*Empty letter (e.g. zero width)*/
+
+    /*If the letter is completely out of mask don't draw it */
+    if(area_union(&masked_a, &letter_area, mask_p) == false) return;
+
+    lv_vdb_t * vdb_p = lv_vdb_get();
+    cord_t vdb_width = area_get_width(&vdb_p->area);
+    cord_t w = area_get_width(&masked_a);
+    cord_t row;
+    cord_t col;
+
+    color_t * vdb_buf_tmp = vdb_p->buf + (masked_a.y1 - vdb_p->area.y1) * vdb_width +
+                                         (masked_a.x1 - vdb_p->area.x1);
+    const uint8_t * mask_tmp = glyph->mask + (masked_a.y1 - letter_area.y1) * glyph->w +
+                                             (masked_a.x1 - letter_area.x1);
+
+    /*Only a few alpha values are used so remember the last prepared one*/
+    sw_mix_t mix;
+    uint8_t alpha_last = 0;
+    uint8_t alpha;
+    for(row = masked_a.y1; row <= masked_a.y2; row++) {
+        for(col = 0; col < w; col++) {
+            alpha = mask_tmp[col];
+            if(alpha == 0) continue;
+            if(alpha == 255 && opa == OPA_COVER) {
+                vdb_buf_tmp[col] = color;
+                continue;
+            }
+
+            if(alpha != alpha_last) {
+                alpha_last = alpha;
+                /*Mix the same way as the letters are drawn without the cache*/
+                if(alpha == 255) sw_mix_init(&mix, color, opa);
+                else if(opa == OPA_COVER) sw_mix_init(&mix, color, alpha);
+                else sw_mix_init(&mix, color, (opa >> 2) * (alpha / 63));
+            }
+            vdb_buf_tmp[col] = sw_mix_px(&mix, vdb_buf_tmp[col]);
+        }
+        mask_tmp += glyph->w;
+        vdb_buf_tmp += vdb_width;
+    }
+}
+#endif
+
 #endif
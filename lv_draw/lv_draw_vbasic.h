@@ -20,6 +20,7 @@ extern "C" {
 #include "misc/gfx/color.h"
 #include "misc/gfx/area.h"
 #include "misc/gfx/font.h"
+#include "lv_grad.h"
 
 /*********************
  *      DEFINES
@@ -34,6 +35,19 @@ extern "C" {
  **********************/
 
 void lv_vpx(cord_t x, cord_t y, const area_t * mask_p, color_t color, opa_t opa);
+
+/**
+ * Put a horizontal row of pixels with the same color but different opacity in the Virtual Display Buffer
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the row
+ * @param dir 1: the next pixels are on the right, -1: on the left
+ * @param mask_p the row will be drawn only on this area (truncated to VDB area)
+ * @param color color of the pixels
+ * @param opa_a opacity of the pixels (0..255)
+ * @param len number of pixels
+ */
+void lv_vpx_row(cord_t x, cord_t y, int8_t dir, const area_t * mask_p,
+                color_t color, const opa_t * opa_a, uint16_t len);
 /**
  * Fill an area in the Virtual Display Buffer
  * @param cords_p coordinates of the area to fill
@@ -44,6 +58,16 @@ void lv_vpx(cord_t x, cord_t y, const area_t * mask_p, color_t color, opa_t opa)
 void lv_vfill(const area_t * cords_p, const area_t * mask_p,
                 color_t color, opa_t opa);
 
+/**
+ * Fill an area in the Virtual Display Buffer with the colors of a gradient
+ * @param cords_p coordinates of the area to fill (a part of the gradient's rectangle)
+ * @param mask_p fill only on this mask
+ * @param grad pointer to a gradient got with 'lv_grad_get'
+ * @param opa opacity of the area (0..255)
+ */
+void lv_vfill_grad(const area_t * cords_p, const area_t * mask_p,
+                   const lv_grad_t * grad, opa_t opa);
+
 /**
  * Draw a letter in the Virtual Display Buffer
  * @param pos_p left-top coordinate of the latter
@@ -0,0 +1,338 @@
+/**
+ * @file lv_gcache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_gcache.h"
+
+#if LV_VDB_SIZE != 0 && LV_GCACHE_SIZE != 0
+
+#include <stddef.h>
+#include <string.h>
+#include "misc/mem/dyn_mem.h"
+#include "misc/mem/linked_list.h"
+#include "../lv_obj/lv_tpool.h"
+
+#if LV_REFR_THREAD_NUM > 1
+#include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_GCACHE_HASH_NUM      64      /*Number of hash lists. Must be power of 2*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _lv_gcache_entry_t
+{
+    lv_gcache_glyph_t glyph;
+    struct _lv_gcache_entry_t * hash_next;  /*Next entry with the same hash*/
+    uint16_t use_cnt;                       /*Number of users drawing the letter now (can't be dropped)*/
+}lv_gcache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_gcache_entry_t * lv_gcache_decode(const font_t * font_p, uint8_t letter);
+static lv_gcache_entry_t * lv_gcache_add(const font_t * font_p, uint8_t letter, uint8_t w, uint8_t h);
+static void lv_gcache_rem(lv_gcache_entry_t * entry);
+static uint8_t lv_gcache_hash(const font_t * font_p, uint8_t letter);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static ll_dsc_t lru_ll;      /*The cached letters. The head is the most recently used*/
+static lv_gcache_entry_t * hash_a[LV_GCACHE_HASH_NUM];
+static uint32_t cache_size;
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
+static uint16_t glyph_num;
+#if LV_REFR_THREAD_NUM > 1
+static pthread_mutex_t gcache_mutex = PTHREAD_MUTEX_INITIALIZER;    /*Only for the cache, not for the blending*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the glyph cache
+ */
+void lv_gcache_init(void)
+{
+    ll_init(&lru_ll, sizeof(lv_gcache_entry_t));
+    memset(hash_a, 0, sizeof(hash_a));
+    cache_size = 0;
+    glyph_num = 0;
+    lv_gcache_reset_stat();
+}
+
+/**
+ * Get the alpha mask of a letter. Decode it from the font if not cached yet.
+ * The least recently used letters are dropped to keep the memory under LV_GCACHE_SIZE.
+ * Can be called from more rendering threads.
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @return pointer to the cached letter or NULL if not exists or there is no enough memory.
+ *         Give it back with 'lv_gcache_release' when the letter is drawn.
+ */
+const lv_gcache_glyph_t * lv_gcache_get(const font_t * font_p, uint8_t letter)
+{
+    if(font_p == NULL) return NULL;
+
+#if LV_REFR_THREAD_NUM > 1
+    pthread_mutex_lock(&gcache_mutex);
+#endif
+
+    lv_gcache_entry_t * entry = hash_a[lv_gcache_hash(font_p, letter)];
+    while(entry != NULL) {
+        if(entry->glyph.font == font_p && entry->glyph.letter == letter) break;
+        entry = entry->hash_next;
+    }
+
+    if(entry != NULL) {
+        hit_cnt ++;
+        /*Move to the head to be the most recently used*/
+        if(ll_get_head(&lru_ll) != entry) ll_chg_list(&lru_ll, &lru_ll, entry);
+    } else {
+        miss_cnt ++;
+        entry = lv_gcache_decode(font_p, letter);
+    }
+
+    if(entry != NULL) entry->use_cnt ++;
+
+#if LV_REFR_THREAD_NUM > 1
+    pthread_mutex_unlock(&gcache_mutex);
+#endif
+
+    if(entry == NULL) return NULL;
+
+    return &entry->glyph;
+}
+
+/**
+ * Give back a letter got with 'lv_gcache_get'. After it the letter can be dropped from the cache.
+ * @param glyph pointer to a cached letter
+ */
+void lv_gcache_release(const lv_gcache_glyph_t * glyph)
+{
+    /*The glyph is the first member of the entry*/
+    lv_gcache_entry_t * entry = (lv_gcache_entry_t *) glyph;
+
+#if LV_REFR_THREAD_NUM > 1
+    pthread_mutex_lock(&gcache_mutex);
+    entry->use_cnt --;
+    pthread_mutex_unlock(&gcache_mutex);
+#else
+    entry->use_cnt --;
+#endif
+}
+
+/**
+ * Remove all letters from the cache (e.g. after a font is changed in the run time)
+ */
+void lv_gcache_clear(void)
+{
+    lv_gcache_entry_t * entry = ll_get_tail(&lru_ll);
+    lv_gcache_entry_t * prev;
+    while(entry != NULL) {
+        prev = ll_get_prev(&lru_ll, entry);
+        if(entry->use_cnt == 0) lv_gcache_rem(entry);
+        entry = prev;
+    }
+}
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_gcache_stat_t' variable to store the result
+ */
+void lv_gcache_get_stat(lv_gcache_stat_t * stat)
+{
+    stat->hit = hit_cnt;
+    stat->miss = miss_cnt;
+    stat->size = cache_size;
+    stat->glyph_num = glyph_num;
+}
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_gcache_reset_stat(void)
+{
+    hit_cnt = 0;
+    miss_cnt = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Decode a letter into an alpha mask and add it to the cache
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @return the new entry or NULL on error
+ */
+static lv_gcache_entry_t * lv_gcache_decode(const font_t * font_p, uint8_t letter)
+{
+    const uint8_t * map_p = font_get_bitmap(font_p, letter);
+    if(map_p == NULL) return NULL;
+
+    uint8_t w = font_get_width(font_p, letter) >> FONT_ANTIALIAS;
+    uint8_t h = font_get_height(font_p) >> FONT_ANTIALIAS;
+    lv_gcache_entry_t * entry;
+
+#if LV_REFR_THREAD_NUM > 1
+    /*The dynamic memory is shared with the other drawings of the threads*/
+    bool busy = lv_tpool_busy();
+    if(busy != false) lv_tpool_lock();
+    entry = lv_gcache_add(font_p, letter, w, h);
+    if(busy != false) lv_tpool_unlock();
+#else
+    entry = lv_gcache_add(font_p, letter, w, h);
+#endif
+    if(entry == NULL) return NULL;
+
+    /*Decode the bitmap of the letter*/
+    uint8_t * mask_tmp = entry->glyph.mask;
+    uint8_t col, row;
+#if FONT_ANTIALIAS != 0
+    /* Count the covered pixels from the 2x2 sub-pixels.
+     * 63 per sub-pixel like 'lv_vletter' without the cache (255 remains for the not anti-aliased fonts)*/
+    static const uint8_t alpha_a[5] = {0, 63, 126, 189, 252};
+    const uint8_t * map1_p;
+    const uint8_t * map2_p;
+    uint8_t px_cnt;
+    uint16_t bit;
+    for(row = 0; row < h; row ++) {
+        map1_p = map_p + (row << 1) * font_p->width_byte;
+        map2_p = map1_p + font_p->width_byte;
+        for(col = 0; col < w; col ++) {
+            bit = col << 1;
+            px_cnt = 0;
+            if((map1_p[bit >> 3] & (0x80 >> (bit & 0x7))) != 0) px_cnt++;
+            if((map2_p[bit >> 3] & (0x80 >> (bit & 0x7))) != 0) px_cnt++;
+            bit ++;
+            if((map1_p[bit >> 3] & (0x80 >> (bit & 0x7))) != 0) px_cnt++;
+            if((map2_p[bit >> 3] & (0x80 >> (bit & 0x7))) != 0) px_cnt++;
+            *mask_tmp = alpha_a[px_cnt];
+            mask_tmp ++;
+        }
+    }
+#else
+    for(row = 0; row < h; row ++) {
+        for(col = 0; col < w; col ++) {
+            if((map_p[col >> 3] & (0x80 >> (col & 0x7))) != 0) *mask_tmp = 255;
+            else *mask_tmp = 0;
+            mask_tmp ++;
+        }
+        map_p += font_p->width_byte;
+    }
+#endif
+
+    return entry;
+}
+
+/**
+ * Allocate a new entry for a letter and add it to the cache
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @param w width of the mask
+ * @param h height of the mask
+ * @return the new entry (its mask is not initialized) or NULL if there is no enough memory
+ */
+static lv_gcache_entry_t * lv_gcache_add(const font_t * font_p, uint8_t letter, uint8_t w, uint8_t h)
+{
+    uint32_t mask_size = (uint32_t) w * h;
+    uint32_t size = mask_size + sizeof(lv_gcache_entry_t);
+
+    if(size > LV_GCACHE_SIZE) return NULL;
+
+    /*Drop the least recently used letters to free enough space (the letters being drawn are kept)*/
+    lv_gcache_entry_t * old = ll_get_tail(&lru_ll);
+    lv_gcache_entry_t * prev;
+    while(old != NULL && cache_size + size > LV_GCACHE_SIZE) {
+        prev = ll_get_prev(&lru_ll, old);
+        if(old->use_cnt == 0) lv_gcache_rem(old);
+        old = prev;
+    }
+
+    if(cache_size + size > LV_GCACHE_SIZE) return NULL;
+
+    uint8_t * mask = NULL;
+    if(mask_size != 0) {
+        mask = dm_alloc(mask_size);
+        if(mask == NULL) return NULL;
+    }
+
+    lv_gcache_entry_t * entry = ll_ins_head(&lru_ll);
+    if(entry == NULL) {
+        if(mask != NULL) dm_free(mask);
+        return NULL;
+    }
+
+    entry->glyph.font = font_p;
+    entry->glyph.letter = letter;
+    entry->glyph.w = w;
+    entry->glyph.h = h;
+    entry->glyph.mask = mask;
+    entry->use_cnt = 0;
+
+    uint8_t hash = lv_gcache_hash(font_p, letter);
+    entry->hash_next = hash_a[hash];
+    hash_a[hash] = entry;
+
+    cache_size += size;
+    glyph_num ++;
+
+    return entry;
+}
+
+/**
+ * Remove an entry from the cache and free its memory
+ * @param entry pointer to an entry of 'lru_ll'
+ */
+static void lv_gcache_rem(lv_gcache_entry_t * entry)
+{
+    /*Unlink from its hash list*/
+    lv_gcache_entry_t ** prev_p = &hash_a[lv_gcache_hash(entry->glyph.font, entry->glyph.letter)];
+    while(*prev_p != NULL) {
+        if(*prev_p == entry) {
+            *prev_p = entry->hash_next;
+            break;
+        }
+        prev_p = &(*prev_p)->hash_next;
+    }
+
+    cache_size -= (uint32_t) entry->glyph.w * entry->glyph.h + sizeof(lv_gcache_entry_t);
+    glyph_num --;
+
+    if(entry->glyph.mask != NULL) dm_free(entry->glyph.mask);
+    ll_rem(&lru_ll, entry);
+    dm_free(entry);
+}
+
+/**
+ * Get the index of the hash list of a letter
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @return index in 'hash_a'
+ */
+static uint8_t lv_gcache_hash(const font_t * font_p, uint8_t letter)
+{
+    uintptr_t h = (uintptr_t) font_p;
+    h = (h >> 4) ^ (h >> 9) ^ letter;
+    return h & (LV_GCACHE_HASH_NUM - 1);
+}
+
+#endif /*LV_VDB_SIZE != 0 && LV_GCACHE_SIZE != 0*/
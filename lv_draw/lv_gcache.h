@@ -0,0 +1,106 @@
+/**
+ * @file lv_gcache.h
+ * Glyph cache: decoded letters as ready-to-blend 8 bit alpha masks
+ */
+
+#ifndef LV_GCACHE_H
+#define LV_GCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_GCACHE_SIZE
+#define LV_GCACHE_SIZE      0
+#endif
+
+#if LV_VDB_SIZE != 0 && LV_GCACHE_SIZE != 0
+
+#include <stdint.h>
+#include "misc/gfx/font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A decoded letter. The mask has the size of the letter on the screen
+ * (the font sizes are already reduced if FONT_ANTIALIAS is enabled)*/
+typedef struct
+{
+    const font_t * font;    /*The font of the letter*/
+    uint8_t * mask;         /*'w * h' alpha values row by row (0: transparent, 63 per covered sub-pixel with FONT_ANTIALIAS, else 255)*/
+    uint8_t letter;         /*The letter*/
+    uint8_t w;              /*Width of the mask*/
+    uint8_t h;              /*Height of the mask*/
+}lv_gcache_glyph_t;
+
+typedef struct
+{
+    uint32_t hit;           /*Number of letters found in the cache*/
+    uint32_t miss;          /*Number of letters decoded from the font*/
+    uint32_t size;          /*Used memory in bytes*/
+    uint16_t glyph_num;     /*Number of cached letters*/
+}lv_gcache_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the glyph cache
+ */
+void lv_gcache_init(void);
+
+/**
+ * Get the alpha mask of a letter. Decode it from the font if not cached yet.
+ * The least recently used letters are dropped to keep the memory under LV_GCACHE_SIZE.
+ * Can be called from more rendering threads.
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @return pointer to the cached letter or NULL if not exists or there is no enough memory.
+ *         Give it back with 'lv_gcache_release' when the letter is drawn.
+ */
+const lv_gcache_glyph_t * lv_gcache_get(const font_t * font_p, uint8_t letter);
+
+/**
+ * Give back a letter got with 'lv_gcache_get'. After it the letter can be dropped from the cache.
+ * @param glyph pointer to a cached letter
+ */
+void lv_gcache_release(const lv_gcache_glyph_t * glyph);
+
+/**
+ * Remove all letters from the cache (e.g. after a font is changed in the run time)
+ */
+void lv_gcache_clear(void);
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_gcache_stat_t' variable to store the result
+ */
+void lv_gcache_get_stat(lv_gcache_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_gcache_reset_stat(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_VDB_SIZE != 0 && LV_GCACHE_SIZE != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_GCACHE_H*/
@@ -0,0 +1,324 @@
+/**
+ * @file lv_grad.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_grad.h"
+
+#include <stddef.h>
+#include "misc/mem/dyn_mem.h"
+#include "misc/mem/linked_list.h"
+#include "../lv_obj/lv_tpool.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_GRAD_CACHE_SIZE != 0
+typedef struct
+{
+    color_t mcolor;
+    color_t gcolor;
+    cord_t len;
+    uint8_t * data;             /*The memory of the colors*/
+}lv_grad_entry_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_grad_calc(uint8_t * data, color_t mcolor, color_t gcolor, cord_t len);
+static void lv_grad_set_data(lv_grad_t * grad, uint8_t * data);
+static uint32_t lv_grad_data_size(cord_t len);
+#if LV_GRAD_CACHE_SIZE != 0
+static void lv_grad_rem(lv_grad_entry_t * entry);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_GRAD_CACHE_SIZE != 0
+static ll_dsc_t lru_ll;      /*The cached gradients. The head is the most recently used*/
+static uint32_t cache_size;
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
+static uint16_t grad_num;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_GRAD_CACHE_SIZE != 0
+/**
+ * Initialize the gradient cache
+ */
+void lv_grad_init(void)
+{
+    ll_init(&lru_ll, sizeof(lv_grad_entry_t));
+    cache_size = 0;
+    grad_num = 0;
+    lv_grad_reset_stat();
+}
+#endif
+
+/**
+ * Get the gradient of a rectangle. Calculate its colors if not cached yet.
+ * @param grad pointer to a 'lv_grad_t' variable to initialize
+ * @param cords_p the coordinates of the rectangle
+ * @param style pointer to the style of the rectangle ('mcolor', 'gcolor' and 'gdir' are used)
+ * @return true: 'grad' is ready; false: no enough memory for the colors.
+ *         Give it back with 'lv_grad_release' when the rectangle is drawn.
+ */
+bool lv_grad_get(lv_grad_t * grad, const area_t * cords_p, const lv_style_t * style)
+{
+    grad->dir = style->gdir;
+    grad->temp = NULL;
+    if(style->gdir == LV_GDIR_HOR) {
+        grad->ofs = cords_p->x1;
+        grad->len = area_get_width(cords_p);
+    } else {
+        grad->ofs = cords_p->y1;
+        grad->len = area_get_height(cords_p);
+    }
+
+    if(grad->len < 1) return false;
+
+    uint32_t data_size = lv_grad_data_size(grad->len);
+    uint8_t * data;
+
+#if LV_GRAD_CACHE_SIZE != 0
+    lv_grad_entry_t * entry;
+    LL_READ(lru_ll, entry) {
+        if(entry->mcolor.full == style->mcolor.full && entry->gcolor.full == style->gcolor.full &&
+           entry->len == grad->len) break;
+    }
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    /* While the bands are rendered in parallel only read the cache.
+     * (The gradients are added before in 'lv_draw_rect_prepare')*/
+    bool busy = lv_tpool_busy();
+#else
+    bool busy = false;
+#endif
+
+    if(entry != NULL) {
+        if(busy == false) {
+            hit_cnt ++;
+            /*Move to the head to be the most recently used*/
+            if(ll_get_head(&lru_ll) != entry) ll_chg_list(&lru_ll, &lru_ll, entry);
+        }
+        lv_grad_set_data(grad, entry->data);
+        return true;
+    }
+
+    uint32_t size = data_size + sizeof(lv_grad_entry_t);
+    if(busy == false && size <= LV_GRAD_CACHE_SIZE) {
+        miss_cnt ++;
+
+        /*Drop the least recently used gradients to free enough space*/
+        while(cache_size + size > LV_GRAD_CACHE_SIZE) {
+            lv_grad_rem(ll_get_tail(&lru_ll));
+        }
+
+        data = dm_alloc(data_size);
+        if(data == NULL) return false;
+
+        entry = ll_ins_head(&lru_ll);
+        if(entry == NULL) {
+            dm_free(data);
+            return false;
+        }
+
+        entry->mcolor = style->mcolor;
+        entry->gcolor = style->gcolor;
+        entry->len = grad->len;
+        entry->data = data;
+        lv_grad_calc(data, style->mcolor, style->gcolor, grad->len);
+
+        cache_size += size;
+        grad_num ++;
+
+        lv_grad_set_data(grad, data);
+        return true;
+    }
+#endif
+
+    /*Calculate the colors temporarily if they can't be cached*/
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    if(lv_tpool_busy() != false) {
+        lv_tpool_lock();
+        data = dm_alloc(data_size);
+        lv_tpool_unlock();
+    } else {
+        data = dm_alloc(data_size);
+    }
+#else
+    data = dm_alloc(data_size);
+#endif
+    if(data == NULL) return false;
+
+    lv_grad_calc(data, style->mcolor, style->gcolor, grad->len);
+    lv_grad_set_data(grad, data);
+    grad->temp = data;
+
+    return true;
+}
+
+/**
+ * Give back a gradient got with 'lv_grad_get'. Free its colors if they were not cached.
+ * @param grad pointer to a gradient
+ */
+void lv_grad_release(lv_grad_t * grad)
+{
+    if(grad->temp == NULL) return;
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    bool busy = lv_tpool_busy();
+    if(busy != false) lv_tpool_lock();
+    dm_free(grad->temp);
+    if(busy != false) lv_tpool_unlock();
+#else
+    dm_free(grad->temp);
+#endif
+
+    grad->temp = NULL;
+}
+
+/**
+ * Get the color of a pixel in a gradient (without dithering)
+ * @param grad pointer to a gradient
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @return the color of the pixel
+ */
+color_t lv_grad_get_color(const lv_grad_t * grad, cord_t x, cord_t y)
+{
+    int32_t i = (grad->dir == LV_GDIR_HOR ? x : y) - grad->ofs;
+    if(i < 0) i = 0;
+    if(i >= grad->len) i = grad->len - 1;
+
+    return grad->color_a[i];
+}
+
+#if LV_GRAD_CACHE_SIZE != 0
+/**
+ * Remove all gradients from the cache
+ */
+void lv_grad_clear(void)
+{
+    lv_grad_entry_t * entry = ll_get_tail(&lru_ll);
+    while(entry != NULL) {
+        lv_grad_rem(entry);
+        entry = ll_get_tail(&lru_ll);
+    }
+}
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_grad_stat_t' variable to store the result
+ */
+void lv_grad_get_stat(lv_grad_stat_t * stat)
+{
+    stat->hit = hit_cnt;
+    stat->miss = miss_cnt;
+    stat->size = cache_size;
+    stat->grad_num = grad_num;
+}
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_grad_reset_stat(void)
+{
+    hit_cnt = 0;
+    miss_cnt = 0;
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Calculate the colors of a gradient the same way as the rows were mixed before
+ * @param data memory for the colors ('lv_grad_data_size' bytes)
+ * @param mcolor the color of the first row (column)
+ * @param gcolor the color after the last row (column)
+ * @param len number of rows (columns)
+ */
+static void lv_grad_calc(uint8_t * data, color_t mcolor, color_t gcolor, cord_t len)
+{
+    color_t * color_a = (color_t *) data;
+#if LV_GRAD_DITHER != 0
+    lv_grad_dith_t * dith_a = (lv_grad_dith_t *)(data + len * sizeof(color_t));
+#endif
+    uint8_t mix;
+    cord_t i;
+
+    for(i = 0; i < len; i++) {
+        mix = (uint32_t)((uint32_t)(len - 1 - i) * 255) / len;
+        color_a[i] = color_mix(mcolor, gcolor, mix);
+
+#if LV_GRAD_DITHER != 0
+        /*Keep 4 more bits of the mixed channels*/
+        dith_a[i].red = (((uint32_t)mcolor.red * mix + (uint32_t)gcolor.red * (255 - mix)) << 4) / 255;
+        dith_a[i].green = (((uint32_t)mcolor.green * mix + (uint32_t)gcolor.green * (255 - mix)) << 4) / 255;
+        dith_a[i].blue = (((uint32_t)mcolor.blue * mix + (uint32_t)gcolor.blue * (255 - mix)) << 4) / 255;
+#endif
+    }
+}
+
+/**
+ * Set the color arrays of a gradient
+ * @param grad pointer to a gradient
+ * @param data the calculated colors (see 'lv_grad_calc')
+ */
+static void lv_grad_set_data(lv_grad_t * grad, uint8_t * data)
+{
+    grad->color_a = (const color_t *) data;
+#if LV_GRAD_DITHER != 0
+    grad->dith_a = (const lv_grad_dith_t *)(data + grad->len * sizeof(color_t));
+#endif
+}
+
+/**
+ * Get the memory needed for the colors of a gradient
+ * @param len number of rows (columns)
+ * @return size in bytes
+ */
+static uint32_t lv_grad_data_size(cord_t len)
+{
+#if LV_GRAD_DITHER == 0
+    return len * sizeof(color_t);
+#else
+    return len * (sizeof(color_t) + sizeof(lv_grad_dith_t));
+#endif
+}
+
+#if LV_GRAD_CACHE_SIZE != 0
+/**
+ * Remove an entry from the cache and free its memory
+ * @param entry pointer to an entry of 'lru_ll'
+ */
+static void lv_grad_rem(lv_grad_entry_t * entry)
+{
+    cache_size -= lv_grad_data_size(entry->len) + sizeof(lv_grad_entry_t);
+    grad_num --;
+
+    dm_free(entry->data);
+    ll_rem(&lru_ll, entry);
+    dm_free(entry);
+}
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file lv_grad.h
+ * Gradient colors of the rectangles prepared once per row (or column) and cached
+ */
+
+#ifndef LV_GRAD_H
+#define LV_GRAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "misc/gfx/area.h"
+#include "misc/gfx/color.h"
+#include "../lv_obj/lv_style.h"
+
+#ifndef LV_GRAD_CACHE_SIZE
+#define LV_GRAD_CACHE_SIZE  0
+#endif
+
+#ifndef LV_GRAD_DITHER
+#define LV_GRAD_DITHER      0
+#endif
+
+#if LV_GRAD_DITHER != 0 && COLOR_DEPTH != 16
+#error "lv_grad: LV_GRAD_DITHER can be used only with COLOR_DEPTH 16"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_GRAD_DITHER != 0
+/*A color of the gradient with 4 fractional bits on every channel*/
+typedef struct
+{
+    uint16_t red;
+    uint16_t green;
+    uint16_t blue;
+}lv_grad_dith_t;
+#endif
+
+/*The gradient of a rectangle*/
+typedef struct
+{
+    const color_t * color_a;        /*'len' colors from 'mcolor' to 'gcolor'*/
+#if LV_GRAD_DITHER != 0
+    const lv_grad_dith_t * dith_a;  /*The same 'len' colors with the fractional parts for dithering*/
+#endif
+    void * temp;                    /*Memory of a not cached gradient (freed by 'lv_grad_release')*/
+    cord_t ofs;                     /*Coordinate of the first row (vertical) or column (horizontal)*/
+    cord_t len;                     /*Height (vertical) or width (horizontal) of the rectangle*/
+    uint8_t dir :1;                 /*Direction from 'lv_gdir_t'*/
+}lv_grad_t;
+
+#if LV_GRAD_CACHE_SIZE != 0
+typedef struct
+{
+    uint32_t hit;           /*Number of gradients found in the cache*/
+    uint32_t miss;          /*Number of calculated gradients*/
+    uint32_t size;          /*Used memory in bytes*/
+    uint16_t grad_num;      /*Number of cached gradients*/
+}lv_grad_stat_t;
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_GRAD_CACHE_SIZE != 0
+/**
+ * Initialize the gradient cache
+ */
+void lv_grad_init(void);
+#endif
+
+/**
+ * Get the gradient of a rectangle. Calculate its colors if not cached yet.
+ * @param grad pointer to a 'lv_grad_t' variable to initialize
+ * @param cords_p the coordinates of the rectangle
+ * @param style pointer to the style of the rectangle ('mcolor', 'gcolor' and 'gdir' are used)
+ * @return true: 'grad' is ready; false: no enough memory for the colors.
+ *         Give it back with 'lv_grad_release' when the rectangle is drawn.
+ */
+bool lv_grad_get(lv_grad_t * grad, const area_t * cords_p, const lv_style_t * style);
+
+/**
+ * Give back a gradient got with 'lv_grad_get'. Free its colors if they were not cached.
+ * @param grad pointer to a gradient
+ */
+void lv_grad_release(lv_grad_t * grad);
+
+/**
+ * Get the color of a pixel in a gradient (without dithering)
+ * @param grad pointer to a gradient
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @return the color of the pixel
+ */
+color_t lv_grad_get_color(const lv_grad_t * grad, cord_t x, cord_t y);
+
+#if LV_GRAD_CACHE_SIZE != 0
+/**
+ * Remove all gradients from the cache
+ */
+void lv_grad_clear(void);
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_grad_stat_t' variable to store the result
+ */
+void lv_grad_get_stat(lv_grad_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_grad_reset_stat(void);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_GRAD_H*/
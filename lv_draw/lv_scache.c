@@ -0,0 +1,332 @@
+/**
+ * @file lv_scache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_scache.h"
+
+#if LV_SCACHE_SIZE != 0
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "misc/gfx/circ.h"
+#include "misc/mem/dyn_mem.h"
+#include "misc/mem/linked_list.h"
+#include "../lv_obj/lv_tpool.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    lv_scache_shadow_t shadow;
+    uint8_t * data;             /*The memory of the rows*/
+}lv_scache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static const lv_scache_shadow_t * lv_scache_temp(cord_t radius, cord_t swidth, opa_t opa);
+static void lv_scache_calc(lv_scache_shadow_t * shadow, uint8_t * data);
+static uint32_t lv_scache_data_size(cord_t radius, cord_t swidth);
+static void lv_scache_rem(lv_scache_entry_t * entry);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static ll_dsc_t lru_ll;      /*The cached shadows. The head is the most recently used*/
+static uint32_t cache_size;
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
+static uint16_t shadow_num;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the shadow cache
+ */
+void lv_scache_init(void)
+{
+    ll_init(&lru_ll, sizeof(lv_scache_entry_t));
+    cache_size = 0;
+    shadow_num = 0;
+    lv_scache_reset_stat();
+}
+
+/**
+ * Get the corner of a shadow. Calculate it if not cached yet.
+ * The least recently used shadows are dropped to keep the memory under LV_SCACHE_SIZE.
+ * @param radius radius of the rectangle (already corrected with its size)
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @return pointer to the shadow or NULL if there is no enough memory.
+ *         Give it back with 'lv_scache_release' when the shadow is drawn.
+ */
+const lv_scache_shadow_t * lv_scache_get(cord_t radius, cord_t swidth, opa_t opa)
+{
+    lv_scache_entry_t * entry;
+    LL_READ(lru_ll, entry) {
+        if(entry->shadow.radius == radius && entry->shadow.swidth == swidth &&
+           entry->shadow.opa == opa) break;
+    }
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    /* While the bands are rendered in parallel only read the cache.
+     * (The shadows are added before in 'lv_draw_rect_prepare')*/
+    if(lv_tpool_busy() != false) {
+        if(entry != NULL) return &entry->shadow;
+        return lv_scache_temp(radius, swidth, opa);
+    }
+#endif
+
+    if(entry != NULL) {
+        hit_cnt ++;
+        /*Move to the head to be the most recently used*/
+        if(ll_get_head(&lru_ll) != entry) ll_chg_list(&lru_ll, &lru_ll, entry);
+        return &entry->shadow;
+    }
+
+    miss_cnt ++;
+
+    uint32_t data_size = lv_scache_data_size(radius, swidth);
+    uint32_t size = data_size + sizeof(lv_scache_entry_t);
+
+    /*Too large to cache*/
+    if(size > LV_SCACHE_SIZE) return lv_scache_temp(radius, swidth, opa);
+
+    /*Drop the least recently used shadows to free enough space*/
+    while(cache_size + size > LV_SCACHE_SIZE) {
+        lv_scache_rem(ll_get_tail(&lru_ll));
+    }
+
+    uint8_t * data = dm_alloc(data_size);
+    if(data == NULL) return NULL;
+
+    entry = ll_ins_head(&lru_ll);
+    if(entry == NULL) {
+        dm_free(data);
+        return NULL;
+    }
+
+    entry->data = data;
+    entry->shadow.radius = radius;
+    entry->shadow.swidth = swidth;
+    entry->shadow.opa = opa;
+    entry->shadow.temp = 0;
+    lv_scache_calc(&entry->shadow, data);
+
+    cache_size += size;
+    shadow_num ++;
+
+    return &entry->shadow;
+}
+
+/**
+ * Give back a shadow got with 'lv_scache_get'. Free it if it was too large to cache.
+ * @param shadow pointer to a shadow
+ */
+void lv_scache_release(const lv_scache_shadow_t * shadow)
+{
+    if(shadow->temp == 0) return;
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    bool busy = lv_tpool_busy();
+    if(busy != false) lv_tpool_lock();
+    dm_free(shadow);
+    if(busy != false) lv_tpool_unlock();
+#else
+    dm_free(shadow);
+#endif
+}
+
+/**
+ * Remove all shadows from the cache
+ */
+void lv_scache_clear(void)
+{
+    lv_scache_entry_t * entry = ll_get_tail(&lru_ll);
+    while(entry != NULL) {
+        lv_scache_rem(entry);
+        entry = ll_get_tail(&lru_ll);
+    }
+}
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_scache_stat_t' variable to store the result
+ */
+void lv_scache_get_stat(lv_scache_stat_t * stat)
+{
+    stat->hit = hit_cnt;
+    stat->miss = miss_cnt;
+    stat->size = cache_size;
+    stat->shadow_num = shadow_num;
+}
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_scache_reset_stat(void)
+{
+    hit_cnt = 0;
+    miss_cnt = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Calculate a shadow without adding it to the cache
+ * @param radius radius of the rectangle
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @return pointer to the shadow (free it with 'lv_scache_release') or NULL if there is no enough memory
+ */
+static const lv_scache_shadow_t * lv_scache_temp(cord_t radius, cord_t swidth, opa_t opa)
+{
+    uint32_t size = sizeof(lv_scache_shadow_t) + lv_scache_data_size(radius, swidth);
+    lv_scache_shadow_t * shadow;
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    bool busy = lv_tpool_busy();
+    if(busy != false) lv_tpool_lock();
+    shadow = dm_alloc(size);
+    if(busy != false) lv_tpool_unlock();
+#else
+    shadow = dm_alloc(size);
+#endif
+    if(shadow == NULL) return NULL;
+
+    shadow->radius = radius;
+    shadow->swidth = swidth;
+    shadow->opa = opa;
+    shadow->temp = 1;
+    lv_scache_calc(shadow, (uint8_t *) shadow + sizeof(lv_scache_shadow_t));
+
+    return shadow;
+}
+
+/**
+ * Blur the corner of a shadow and store its rows
+ * @param shadow pointer to a shadow with initialized 'radius', 'swidth' and 'opa'
+ * @param data memory for the rows ('lv_scache_data_size' bytes)
+ */
+static void lv_scache_calc(lv_scache_shadow_t * shadow, uint8_t * data)
+{
+    cord_t radius = shadow->radius;
+    cord_t swidth = shadow->swidth;
+    opa_t opa = shadow->opa;
+    uint16_t row_num = radius + swidth;
+
+    cord_t * curve = (cord_t *) data;
+    uint16_t * len = (uint16_t *)(data + row_num * sizeof(cord_t));
+    opa_t * opa_a = (opa_t *)(data + row_num * (sizeof(cord_t) + sizeof(uint16_t)));
+
+    shadow->row_num = row_num;
+    shadow->curve = curve;
+    shadow->len = len;
+    shadow->opa_a = opa_a;
+
+    /*The rows below the circle are not shifted*/
+    memset(curve, 0, row_num * sizeof(cord_t));
+    point_t circ;
+    cord_t circ_tmp;
+    circ_init(&circ, &circ_tmp, radius);
+    while(circ_cont(&circ)) {
+        curve[CIRC_OCT1_Y(circ)] = CIRC_OCT1_X(circ);
+        curve[CIRC_OCT2_Y(circ)] = CIRC_OCT2_X(circ);
+        circ_next(&circ, &circ_tmp);
+    }
+
+    int16_t row;
+    uint16_t opa_h_result[LV_HOR_RES];
+    int16_t filter_size = 2 * swidth + 1;
+
+    for(row = 0; row < filter_size; row++) {
+        opa_h_result[row] = (uint32_t)((uint32_t)(filter_size - row) * opa * 2) / (filter_size);
+    }
+
+    uint16_t p;
+    opa_t * opa_v_result;
+    for(row = 0; row < row_num; row++) {
+        opa_v_result = &opa_a[row * row_num];
+        for(p = 0; p < row_num; p++) {
+            int16_t v;
+            uint32_t opa_tmp = 0;
+            int16_t row_v;
+            bool swidth_out = false;
+            for(v = -swidth; v < swidth; v++) {
+                row_v = row + v;
+                if(row_v < 0) row_v = 0; /*Rows above the corner*/
+
+                /*Rows below the bottom are empty so they won't modify the filter*/
+                if(row_v > radius) break;
+
+                int16_t p_tmp = p - (curve[row_v] - curve[row]);
+                if(p_tmp < -swidth) { /*Cols before the filtered shadow (still not blurred)*/
+                    opa_tmp += opa * 2;
+                }
+                /*Cols after the filtered shadow (already no effect) */
+                else if(p_tmp > swidth) {
+                    /* If on the current point the  filter top point is already out of swidth then
+                     * the remaining part will not do not anything on this point*/
+                    if(v == -swidth) swidth_out = true;
+                    break;
+                } else {
+                    opa_tmp += opa_h_result[p_tmp + swidth];
+                }
+            }
+
+            if(swidth_out != false) break;
+
+            opa_tmp = opa_tmp / (filter_size);
+            opa_v_result[p] = opa_tmp > OPA_COVER ? OPA_COVER : opa_tmp;
+        }
+
+        len[row] = p;
+    }
+}
+
+/**
+ * Get the memory needed for the rows of a shadow
+ * @param radius radius of the rectangle
+ * @param swidth width of the shadow
+ * @return size in bytes
+ */
+static uint32_t lv_scache_data_size(cord_t radius, cord_t swidth)
+{
+    uint32_t row_num = radius + swidth;
+    return row_num * (sizeof(cord_t) + sizeof(uint16_t) + row_num);
+}
+
+/**
+ * Remove an entry from the cache and free its memory
+ * @param entry pointer to an entry of 'lru_ll'
+ */
+static void lv_scache_rem(lv_scache_entry_t * entry)
+{
+    cache_size -= lv_scache_data_size(entry->shadow.radius, entry->shadow.swidth) + sizeof(lv_scache_entry_t);
+    shadow_num --;
+
+    dm_free(entry->data);
+    ll_rem(&lru_ll, entry);
+    dm_free(entry);
+}
+
+#endif /*LV_SCACHE_SIZE != 0*/
@@ -0,0 +1,111 @@
+/**
+ * @file lv_scache.h
+ * Shadow cache: the blurred corners of the full shadows as ready-to-blend opacity rows
+ */
+
+#ifndef LV_SCACHE_H
+#define LV_SCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_SCACHE_SIZE
+#define LV_SCACHE_SIZE      0
+#endif
+
+#if LV_SCACHE_SIZE != 0
+
+#include <stdint.h>
+#include "misc/gfx/area.h"
+#include "misc/gfx/color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The right bottom corner of a shadow. The other corners are mirrored.
+ * Row 'i' is 'i' pixels below the center of the corner and
+ * its first pixel is 'curve[i]' pixels right from the center.*/
+typedef struct
+{
+    const cord_t * curve;   /*'row_num' horizontal offsets*/
+    const uint16_t * len;   /*'row_num' number of pixels in the rows*/
+    const opa_t * opa_a;    /*The opacities of the pixels. Row 'i' starts at 'i * row_num'*/
+    cord_t radius;          /*Radius of the rectangle (after the size correction)*/
+    cord_t swidth;          /*Width of the shadow*/
+    uint16_t row_num;       /*radius + swidth*/
+    opa_t opa;              /*Opacity of the shadow*/
+    uint8_t temp :1;        /*1: not cached, freed by 'lv_scache_release'*/
+}lv_scache_shadow_t;
+
+typedef struct
+{
+    uint32_t hit;           /*Number of shadows found in the cache*/
+    uint32_t miss;          /*Number of calculated shadows*/
+    uint32_t size;          /*Used memory in bytes*/
+    uint16_t shadow_num;    /*Number of cached shadows*/
+}lv_scache_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the shadow cache
+ */
+void lv_scache_init(void);
+
+/**
+ * Get the corner of a shadow. Calculate it if not cached yet.
+ * The least recently used shadows are dropped to keep the memory under LV_SCACHE_SIZE.
+ * @param radius radius of the rectangle (already corrected with its size)
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @return pointer to the shadow or NULL if there is no enough memory.
+ *         Give it back with 'lv_scache_release' when the shadow is drawn.
+ */
+const lv_scache_shadow_t * lv_scache_get(cord_t radius, cord_t swidth, opa_t opa);
+
+/**
+ * Give back a shadow got with 'lv_scache_get'. Free it if it was too large to cache.
+ * @param shadow pointer to a shadow
+ */
+void lv_scache_release(const lv_scache_shadow_t * shadow);
+
+/**
+ * Remove all shadows from the cache
+ */
+void lv_scache_clear(void);
+
+/**
+ * Get the statistics of the cache
+ * @param stat pointer to a 'lv_scache_stat_t' variable to store the result
+ */
+void lv_scache_get_stat(lv_scache_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters
+ */
+void lv_scache_reset_stat(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_SCACHE_SIZE != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_SCACHE_H*/
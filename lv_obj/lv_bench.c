@@ -0,0 +1,395 @@
+/**
+ * @file lv_bench.c
+ * 
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_bench.h"
+#if LV_BENCH != 0
+
+#include <stdio.h>
+#include <string.h>
+#include "misc/mem/dyn_mem.h"
+#include "hal/systick/systick.h"
+#include "lv_obj.h"
+#include "lv_refr.h"
+#include "../lv_objx/lv_label.h"
+#include "../lv_objx/lv_img.h"
+#include "../lv_objx/lv_chart.h"
+#include "../lv_objx/lv_gauge.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_IMG_W     40
+#define BENCH_IMG_H     40
+#define BENCH_IMG_FN    "bench_img"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    const char * name;
+    void (*create)(lv_obj_t * scr);
+}lv_bench_scene_t;
+
+/*An image in the same format as the output of the image converter*/
+typedef struct
+{
+    lv_img_raw_header_t header;
+    color_t map[BENCH_IMG_W * BENCH_IMG_H];
+}lv_bench_img_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void scene_fill(lv_obj_t * scr);
+static void scene_radius(lv_obj_t * scr);
+static void scene_shadow_full(lv_obj_t * scr);
+static void scene_shadow_bottom(lv_obj_t * scr);
+#if USE_LV_LABEL != 0
+static void scene_label(lv_obj_t * scr);
+#endif
+#if USE_LV_IMG != 0
+static void scene_img_upscale(lv_obj_t * scr);
+static void scene_img_transp(lv_obj_t * scr);
+static void bench_img_init(void);
+#endif
+#if USE_LV_CHART != 0
+static void scene_chart(lv_obj_t * scr);
+#endif
+#if USE_LV_GAUGE != 0
+static void scene_gauge(lv_obj_t * scr);
+#endif
+static void obj_grid(lv_obj_t * scr, lv_style_t * style);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t (*time_f)(void) = systick_get;
+static lv_style_t style_scr;
+static lv_style_t style_obj;
+#if USE_LV_IMG != 0
+static lv_bench_img_t bench_img;
+#endif
+
+static const lv_bench_scene_t scenes[] = {
+    {"fill", scene_fill},
+    {"radius", scene_radius},
+    {"shadow_full", scene_shadow_full},
+    {"shadow_bottom", scene_shadow_bottom},
+#if USE_LV_LABEL != 0
+    {"label_recolor", scene_label},
+#endif
+#if USE_LV_IMG != 0
+    {"img_upscale", scene_img_upscale},
+    {"img_transp", scene_img_transp},
+#endif
+#if USE_LV_CHART != 0
+    {"chart", scene_chart},
+#endif
+#if USE_LV_GAUGE != 0
+    {"gauge", scene_gauge},
+#endif
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Set the time source of the benchmark. 'systick_get' (1 ms) is used by default.
+ * @param time_cb pointer to a function which returns the current time (e.g. in us)
+ */
+void lv_bench_set_time_cb(uint32_t (*time_cb)(void))
+{
+    if(time_cb == NULL) time_cb = systick_get;
+    time_f = time_cb;
+}
+
+/**
+ * Load the scenes one by one, refresh each of them LV_BENCH_FRAME_NUM times and print the results.
+ * 'lv_init()' has to be called before and the display driver ('disp_map', 'disp_fill' ...)
+ * can write to a frame buffer in the memory.
+ * The output is comma separated, one line for each scene after a header line:
+ * scene,frames,time_per_frame,px_per_frame,px_per_time,mem_cnt_delta,mem_size_delta
+ * px_per_frame: the flushed pixels of the display (downscaled with LV_ANTIALIAS)
+ * mem_cnt_delta, mem_size_delta: change of the used memory blocks and bytes while the scene was alive
+ * @param print_cb pointer to a function which prints a '\0' terminated line
+ */
+void lv_bench_run(void (*print_cb)(const char * txt))
+{
+    char buf[128];
+    lv_obj_t * scr_ori = lv_scr_act();
+    uint16_t i;
+    uint16_t f;
+
+#if USE_LV_IMG != 0
+    bench_img_init();
+#endif
+
+    lv_style_get(LV_STYLE_PLAIN, &style_scr);
+    style_scr.radius = 0;
+    style_scr.bwidth = 0;
+
+    print_cb("scene,frames,time_per_frame,px_per_frame,px_per_time,mem_cnt_delta,mem_size_delta\n");
+
+    for(i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+        dm_mon_t mon_start;
+        dm_mon_t mon_end;
+        dm_monitor(&mon_start);
+
+        lv_obj_t * scr = lv_obj_create(NULL, NULL);
+        lv_obj_set_style(scr, &style_scr);
+        scenes[i].create(scr);
+        lv_scr_load(scr);
+
+        /*Redraw the whole screen in every frame*/
+        uint32_t time_sum = 0;
+        uint32_t px_sum = 0;
+        for(f = 0; f < LV_BENCH_FRAME_NUM; f++) {
+            lv_obj_inv(scr);
+            uint32_t t_start = time_f();
+            lv_refr_now();
+            time_sum += time_f() - t_start;
+            /*The whole screen is flushed (the VDB is downscaled with LV_ANTIALIAS)*/
+            px_sum += (uint32_t)(LV_HOR_RES / LV_DOWNSCALE) * (LV_VER_RES / LV_DOWNSCALE);
+        }
+
+        dm_monitor(&mon_end);
+
+        uint32_t px_per_time = time_sum != 0 ? px_sum / time_sum : 0;
+        sprintf(buf, "%s,%u,%lu,%lu,%lu,%ld,%ld\n", scenes[i].name, LV_BENCH_FRAME_NUM,
+                (unsigned long)(time_sum / LV_BENCH_FRAME_NUM), (unsigned long)(px_sum / LV_BENCH_FRAME_NUM),
+                (unsigned long)px_per_time,
+                (long)mon_end.cnt_used - (long)mon_start.cnt_used,
+                ((long)mon_start.size_free - (long)mon_end.size_free));
+        print_cb(buf);
+
+        lv_scr_load(scr_ori);
+        lv_obj_del(scr);
+    }
+
+    lv_obj_inv(scr_ori);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Only the screen: one big fill
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_fill(lv_obj_t * scr)
+{
+    (void) scr;     /*The screen's plain style is enough*/
+}
+
+/**
+ * Rectangles with gradient, radius and border
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_radius(lv_obj_t * scr)
+{
+    lv_style_get(LV_STYLE_PRETTY_COLOR, &style_obj);
+    style_obj.radius = LV_DPI / 6;
+    style_obj.swidth = 0;
+    obj_grid(scr, &style_obj);
+}
+
+/**
+ * Rectangles with full shadow
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_shadow_full(lv_obj_t * scr)
+{
+    lv_style_get(LV_STYLE_PRETTY_COLOR, &style_obj);
+    style_obj.radius = LV_DPI / 6;
+    style_obj.swidth = LV_DPI / 8;
+    style_obj.stype = LV_STYPE_FULL;
+    obj_grid(scr, &style_obj);
+}
+
+/**
+ * Rectangles with bottom shadow
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_shadow_bottom(lv_obj_t * scr)
+{
+    lv_style_get(LV_STYLE_PRETTY_COLOR, &style_obj);
+    style_obj.radius = LV_DPI / 6;
+    style_obj.swidth = LV_DPI / 8;
+    style_obj.stype = LV_STYPE_BOTTOM;
+    obj_grid(scr, &style_obj);
+}
+
+#if USE_LV_LABEL != 0
+/**
+ * A long text with re-colored words
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_label(lv_obj_t * scr)
+{
+    lv_obj_t * label = lv_label_create(scr, NULL);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_size(label, LV_HOR_RES, LV_VER_RES);
+    lv_label_set_recolor(label, true);
+    lv_label_set_text_static(label,
+            "Lorem ipsum dolor sit amet, #ff0000 consectetur# adipiscing elit, "
+            "sed do eiusmod tempor #00ff00 incididunt# ut labore et dolore magna aliqua. "
+            "Ut enim ad minim veniam, quis #0000ff nostrud exercitation# ullamco laboris "
+            "nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit "
+            "in voluptate velit esse cillum dolore eu fugiat nulla pariatur.");
+}
+#endif
+
+#if USE_LV_IMG != 0
+/**
+ * Images upscaled with re-color
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_img_upscale(lv_obj_t * scr)
+{
+    lv_style_get(LV_STYLE_PLAIN, &style_obj);
+    style_obj.img_recolor = OPA_30;
+    style_obj.ccolor = COLOR_RED;
+
+    cord_t x;
+    cord_t y;
+    for(y = 0; y < LV_VER_RES; y += BENCH_IMG_H * 2) {
+        for(x = 0; x < LV_HOR_RES; x += BENCH_IMG_W * 2) {
+            lv_obj_t * img = lv_img_create(scr, NULL);
+            lv_img_set_upscale(img, true);
+            lv_img_set_file(img, "U:/"BENCH_IMG_FN);
+            lv_obj_set_style(img, &style_obj);
+            lv_obj_set_pos(img, x, y);
+        }
+    }
+}
+
+/**
+ * Overlapping images with transparent pixels and opacity
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_img_transp(lv_obj_t * scr)
+{
+    lv_style_get(LV_STYLE_PLAIN, &style_obj);
+    style_obj.opa = OPA_60;
+
+    cord_t x;
+    cord_t y;
+    for(y = 0; y < LV_VER_RES; y += BENCH_IMG_H / 2) {
+        for(x = 0; x < LV_HOR_RES; x += BENCH_IMG_W / 2) {
+            lv_obj_t * img = lv_img_create(scr, NULL);
+            lv_img_set_file(img, "U:/"BENCH_IMG_FN);
+            lv_obj_set_style(img, &style_obj);
+            lv_obj_set_pos(img, x, y);
+        }
+    }
+}
+
+/**
+ * Create a test image with a checker pattern and transparent pixels on the diagonal
+ */
+static void bench_img_init(void)
+{
+    static bool inited = false;
+    if(inited != false) return;
+
+    bench_img.header.w = BENCH_IMG_W;
+    bench_img.header.h = BENCH_IMG_H;
+    bench_img.header.transp = 1;
+    bench_img.header.cd = 0;
+
+    cord_t x;
+    cord_t y;
+    color_t * px = bench_img.map;
+    for(y = 0; y < BENCH_IMG_H; y++) {
+        for(x = 0; x < BENCH_IMG_W; x++) {
+            if(x == y || x == BENCH_IMG_W - 1 - y) *px = LV_COLOR_TRANSP;
+            else if(((x >> 2) ^ (y >> 2)) & 0x1) *px = COLOR_NAVY;
+            else *px = COLOR_YELLOW;
+            px++;
+        }
+    }
+
+    lv_img_create_file(BENCH_IMG_FN, (const color_int_t *) &bench_img);
+    inited = true;
+}
+#endif
+
+#if USE_LV_CHART != 0
+/**
+ * Line charts with many points
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_chart(lv_obj_t * scr)
+{
+    lv_obj_t * chart = lv_chart_create(scr, NULL);
+    lv_obj_set_size(chart, LV_HOR_RES, LV_VER_RES);
+    lv_chart_set_pnum(chart, 64);
+
+    lv_chart_dl_t * dl1 = lv_chart_add_data_line(chart, COLOR_RED);
+    lv_chart_dl_t * dl2 = lv_chart_add_data_line(chart, COLOR_BLUE);
+    uint16_t i;
+    for(i = 0; i < 64; i++) {
+        lv_chart_set_next(chart, dl1, (i * 37) % 100);
+        lv_chart_set_next(chart, dl2, (i * 61) % 100);
+    }
+}
+#endif
+
+#if USE_LV_GAUGE != 0
+/**
+ * Gauges with needles
+ * @param scr pointer to the screen of the scene
+ */
+static void scene_gauge(lv_obj_t * scr)
+{
+    cord_t size = LV_VER_RES / 2;
+    cord_t x;
+    cord_t y;
+    int16_t value = 10;
+    for(y = 0; y + size <= LV_VER_RES; y += size) {
+        for(x = 0; x + size <= LV_HOR_RES; x += size) {
+            lv_obj_t * gauge = lv_gauge_create(scr, NULL);
+            lv_obj_set_size(gauge, size, size);
+            lv_obj_set_pos(gauge, x, y);
+            lv_gauge_set_value(gauge, 0, value);
+            value += 20;
+        }
+    }
+}
+#endif
+
+/**
+ * Fill the screen with objects using a style
+ * @param scr pointer to the screen of the scene
+ * @param style pointer to the style of the objects
+ */
+static void obj_grid(lv_obj_t * scr, lv_style_t * style)
+{
+    cord_t w = LV_HOR_RES / 4;
+    cord_t h = LV_VER_RES / 4;
+    cord_t x;
+    cord_t y;
+
+    for(y = 0; y + h <= LV_VER_RES; y += h) {
+        for(x = 0; x + w <= LV_HOR_RES; x += w) {
+            lv_obj_t * obj = lv_obj_create(scr, NULL);
+            lv_obj_set_style(obj, style);
+            lv_obj_set_pos(obj, x + w / 8, y + h / 8);
+            lv_obj_set_size(obj, w - w / 4, h - h / 4);
+        }
+    }
+}
+
+#endif /*LV_BENCH != 0*/
@@ -0,0 +1,69 @@
+/**
+ * @file lv_bench.h
+ * Draw a set of scenes and measure their refresh time without a GUI application
+ */
+
+#ifndef LV_BENCH_H
+#define LV_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_BENCH
+#define LV_BENCH    0
+#endif
+
+#if LV_BENCH != 0
+
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_BENCH_FRAME_NUM
+#define LV_BENCH_FRAME_NUM  10
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the time source of the benchmark. 'systick_get' (1 ms) is used by default.
+ * @param time_cb pointer to a function which returns the current time (e.g. in us)
+ */
+void lv_bench_set_time_cb(uint32_t (*time_cb)(void));
+
+/**
+ * Load the scenes one by one, refresh each of them LV_BENCH_FRAME_NUM times and print the results.
+ * 'lv_init()' has to be called before and the display driver ('disp_map', 'disp_fill' ...)
+ * can write to a frame buffer in the memory.
+ * The output is comma separated, one line for each scene after a header line:
+ * scene,frames,time_per_frame,px_per_frame,px_per_time,mem_cnt_delta,mem_size_delta
+ * px_per_frame: the flushed pixels of the display (downscaled with LV_ANTIALIAS)
+ * mem_cnt_delta, mem_size_delta: change of the used memory blocks and bytes while the scene was alive
+ * @param print_cb pointer to a function which prints a '\0' terminated line
+ */
+void lv_bench_run(void (*print_cb)(const char * txt));
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_BENCH != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_BENCH_H*/
@@ -10,19 +10,76 @@
 
 #include "misc/os/ptask.h"
 #include "misc/math/math_base.h"
+#include "misc/mem/dyn_mem.h"
 #include "lv_dispi.h"
 #include "../lv_draw/lv_draw_rbasic.h"
 #include "hal/indev/indev.h"
 #include "hal/systick/systick.h"
 #include "lv_obj.h"
+#include "lv_refr.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_DISPI_HIT_GRID != 0
+#define LV_DISPI_HIT_CELL_W     ((LV_HOR_RES + LV_DISPI_HIT_GRID - 1) / LV_DISPI_HIT_GRID)
+#define LV_DISPI_HIT_CELL_H     ((LV_VER_RES + LV_DISPI_HIT_GRID - 1) / LV_DISPI_HIT_GRID)
+#define LV_DISPI_HIT_CELL_NUM   (LV_DISPI_HIT_GRID * LV_DISPI_HIT_GRID)
+#endif
+
+#if LV_DISPI_QUEUE_SIZE != 0
+#define LV_DISPI_HIST_NUM       8       /*Number of recent pressed samples to calculate the drag throw*/
+#define LV_DISPI_HIST_TIME      100     /*Use the samples of the last this many milliseconds to calculate the drag throw*/
+
+/* Move the indexes of the queues with acquire-release ordering: a sample is written
+ * (read) before the other side can see the new 'head' ('tail').
+ * Redefine them in lv_conf.h if the compiler has no '__atomic' built-ins*/
+#ifndef LV_DISPI_ATOMIC_LOAD
+#define LV_DISPI_ATOMIC_LOAD(var)           __atomic_load_n(&(var), __ATOMIC_ACQUIRE)
+#endif
+
+#ifndef LV_DISPI_ATOMIC_STORE
+#define LV_DISPI_ATOMIC_STORE(var, value)   __atomic_store_n(&(var), (value), __ATOMIC_RELEASE)
+#endif
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DISPI_HIT_GRID != 0
+/*A clickable object in the hit-test index*/
+typedef struct
+{
+    lv_obj_t * obj;
+    area_t area;        /*The clickable area: the coordinates of 'obj' cropped by its parents*/
+}lv_dispi_hit_t;
+#endif
+
+#if LV_DISPI_QUEUE_SIZE != 0
+/*A sample of an input device*/
+typedef struct
+{
+    uint32_t time;      /*Time stamp in milliseconds ('systick_get')*/
+    cord_t x;
+    cord_t y;
+    bool pressed;
+}lv_dispi_sample_t;
+
+/*The samples of an input device.
+ * 'lv_dispi_push' writes only 'head' and 'dispi_task' writes only 'tail' (see LV_DISPI_ATOMIC_STORE)*/
+typedef struct
+{
+    lv_dispi_sample_t buf[LV_DISPI_QUEUE_SIZE];
+    volatile uint16_t head;                     /*Index of the next pushed sample*/
+    volatile uint16_t tail;                     /*Index of the next sample to process*/
+    volatile bool used;                         /*Samples were pushed: don't read the device with 'indev_get'*/
+    lv_dispi_sample_t last;                     /*The last processed sample*/
+    lv_dispi_sample_t hist[LV_DISPI_HIST_NUM];  /*The recent pressed samples (ring buffer)*/
+    uint8_t hist_next;                          /*Index of the next sample in 'hist'*/
+    uint8_t hist_cnt;                           /*Number of samples in 'hist'*/
+}lv_dispi_queue_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -32,8 +89,20 @@ static void dispi_proc_point(lv_dispi_t * dispi_p, cord_t x, cord_t y);
 static void dispi_proc_press(lv_dispi_t * dispi_p);
 static void disi_proc_release(lv_dispi_t * dispi_p);
 static lv_obj_t * dispi_search_obj(const lv_dispi_t * dispi_p, lv_obj_t * obj);
+#if LV_DISPI_HIT_GRID != 0
+static lv_obj_t * dispi_hit_search(const lv_dispi_t * dispi_p);
+static bool dispi_hit_refr(void);
+static bool dispi_hit_upd(lv_obj_t * obj);
+static bool dispi_hit_cell_refr(void);
+static uint32_t dispi_hit_collect(lv_obj_t * obj, const area_t * par_area_p, uint32_t hit_cnt, lv_dispi_hit_t * buf);
+static bool dispi_hit_is_in(lv_obj_t * obj, lv_obj_t * par);
+#endif
 static void dispi_drag(lv_dispi_t * dispi_p);
 static void dispi_drag_throw(lv_dispi_t * dispi_p);
+#if LV_DISPI_QUEUE_SIZE != 0
+static void dispi_queue_proc(uint8_t indev_id);
+static void dispi_queue_vect(lv_dispi_queue_t * q, lv_dispi_t * dispi_p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -42,6 +111,20 @@ static ptask_t* dispi_task_p;
 static bool lv_dispi_reset_qry;
 static bool lv_dispi_reset_now;
 static lv_dispi_t dispi_array[INDEV_NUM];
+#if LV_DISPI_HIT_GRID != 0
+static lv_dispi_hit_t * hit_a;          /*The clickable objects in the order of 'dispi_search_obj'*/
+static uint32_t hit_num;
+static uint32_t hit_a_size;             /*Allocated elements in 'hit_a'*/
+static uint16_t * hit_cell_a;           /*Indexes of 'hit_a' grouped by cells*/
+static uint32_t hit_cell_size;          /*Allocated elements in 'hit_cell_a'*/
+static uint32_t hit_cell_start[LV_DISPI_HIT_CELL_NUM + 1]; /*The first index of the cells in 'hit_cell_a'*/
+static lv_obj_t * hit_scr;              /*The indexed screen*/
+static lv_obj_t * hit_moved;            /*Its coordinates or its children's are changed since the last update (NULL: none)*/
+static bool hit_valid;
+#endif
+#if LV_DISPI_QUEUE_SIZE != 0
+static lv_dispi_queue_t dispi_queue[INDEV_NUM];
+#endif
 
 /**********************
  *      MACROS
@@ -59,13 +142,64 @@ void lv_dispi_init(void)
     lv_dispi_reset_qry = false;
     lv_dispi_reset_now = false;
 
-#if LV_DISPI_READ_PERIOD != 0
+#if LV_DISPI_HIT_GRID != 0
+    hit_a = NULL;
+    hit_num = 0;
+    hit_a_size = 0;
+    hit_cell_a = NULL;
+    hit_cell_size = 0;
+    hit_scr = NULL;
+    hit_moved = NULL;
+    hit_valid = false;
+#endif
+
+#if LV_DISPI_QUEUE_SIZE != 0
+    memset(dispi_queue, 0, sizeof(dispi_queue));
+#endif
+
+#if LV_REFR_FRAME_SYNC != 0
+    dispi_task_p = NULL;    /*'lv_dispi_proc' is called in the frame task of 'lv_refr'*/
+#elif LV_DISPI_READ_PERIOD != 0
     dispi_task_p = ptask_create(dispi_task, LV_DISPI_READ_PERIOD, PTASK_PRIO_MID, NULL);
 #else
     dispi_task_p = ptask_create(dispi_task, 1, PTASK_PRIO_OFF); /*Not use lv_dispi*/
 #endif
 }
 
+/**
+ * Read and process the display inputs once.
+ * Called periodically by the display input task or by the frame task (see LV_REFR_FRAME_SYNC)
+ */
+void lv_dispi_proc(void)
+{
+	cord_t x;
+	cord_t y;
+	uint8_t i;
+
+	for (i = 0; i < INDEV_NUM; i++) {
+#if LV_DISPI_QUEUE_SIZE != 0
+	    /*Process the pushed samples instead of reading the device*/
+	    if(LV_DISPI_ATOMIC_LOAD(dispi_queue[i].used) != false) {
+	        dispi_queue_proc(i);
+	        continue;
+	    }
+#endif
+		dispi_array[i].pressed = indev_get(i, &x, &y);
+		dispi_proc_point(&dispi_array[i], x, y);
+	}
+
+    /*If reset query occurred in this round then set a flag to 
+     * ask the dispis to reset themself in the next round  */
+    if(lv_dispi_reset_qry != false) {
+        lv_dispi_reset_qry = false;
+        lv_dispi_reset_now = true;
+    } 
+    /*If now a reset occurred then clear the flag*/
+    else if (lv_dispi_reset_now != false){
+        lv_dispi_reset_now = false;
+    }
+}
+
 /**
  * Get an array with all the display inputs. Contains (INDEV_NUM elements)
  * @return pointer to a an lv_dispi_t array.
@@ -135,6 +269,75 @@ void lv_dispi_wait_release(lv_dispi_t * dispi)
     dispi->wait_release = 1;
 }
 
+#if LV_DISPI_QUEUE_SIZE != 0
+/**
+ * Push a sample of an input device into its queue. Can be called from an interrupt or
+ * an other thread (one caller per input device). After the first sample the device
+ * is not read with 'indev_get' anymore.
+ * @param indev_id index of the input device (< INDEV_NUM)
+ * @param pressed true: the input device is pressed
+ * @param x x coordinate of the point
+ * @param y y coordinate of the point
+ * @return true: the sample is saved, false: the queue is full, the sample is lost
+ */
+bool lv_dispi_push(uint8_t indev_id, bool pressed, cord_t x, cord_t y)
+{
+    lv_dispi_queue_t * q = &dispi_queue[indev_id];
+    uint16_t head = q->head;
+    uint16_t next = (head + 1) % LV_DISPI_QUEUE_SIZE;
+
+    /*One place is always free to distinguish the full and the empty queue*/
+    if(next == LV_DISPI_ATOMIC_LOAD(q->tail)) return false;
+
+    q->buf[head].time = systick_get();
+    q->buf[head].x = x;
+    q->buf[head].y = y;
+    q->buf[head].pressed = pressed;
+
+    /*Publish the sample only when it's ready*/
+    LV_DISPI_ATOMIC_STORE(q->head, next);
+    LV_DISPI_ATOMIC_STORE(q->used, true);
+
+    return true;
+}
+#endif
+
+#if LV_DISPI_HIT_GRID != 0
+/**
+ * Mark the index of the clickable objects as outdated.
+ * Has to be called when the hierarchy or the clickable/hidden attributes of an object change.
+ * @param obj pointer to the changed object. Ignored if it is not on the indexed screen.
+ */
+void lv_dispi_hit_inv(lv_obj_t * obj)
+{
+    if(lv_obj_get_scr(obj) != hit_scr) return;
+
+    hit_valid = false;
+    hit_moved = NULL;
+}
+
+/**
+ * Tell the index that the coordinates of an object are changed.
+ * Only the entries of the object and its children will be updated before the next search.
+ * @param obj pointer to the moved or resized object. Ignored if it is not on the indexed screen.
+ */
+void lv_dispi_hit_move(lv_obj_t * obj)
+{
+    if(hit_valid == false) return;
+    if(lv_obj_get_scr(obj) != hit_scr) return;
+
+    if(hit_moved == NULL) {
+        hit_moved = obj;
+        return;
+    }
+
+    /*Update the common parent of the moved objects*/
+    lv_obj_t * par = hit_moved;
+    while(dispi_hit_is_in(obj, par) == false) par = lv_obj_get_parent(par);
+    hit_moved = par;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -145,26 +348,91 @@ void lv_dispi_wait_release(lv_dispi_t * dispi)
  */
 static void dispi_task(void * param)
 {
-	cord_t x;
-	cord_t y;
-	uint8_t i;
+    lv_dispi_proc();
+}
 
-	for (i = 0; i < INDEV_NUM; i++) {
-		dispi_array[i].pressed = indev_get(i, &x, &y);
-		dispi_proc_point(&dispi_array[i], x, y);
-	}
+#if LV_DISPI_QUEUE_SIZE != 0
+/**
+ * Process the queued samples of an input device.
+ * The moves in the same state are coalesced: only the last sample before a press or
+ * release is processed, but all pressed samples are used for the drag throw.
+ * @param indev_id index of the input device
+ */
+static void dispi_queue_proc(uint8_t indev_id)
+{
+    lv_dispi_queue_t * q = &dispi_queue[indev_id];
+    lv_dispi_t * dispi_p = &dispi_array[indev_id];
+    lv_dispi_sample_t sample;
+    uint16_t next;
+    uint16_t head = LV_DISPI_ATOMIC_LOAD(q->head);
+    bool proc = false;
+
+    while(q->tail != head) {
+        /*Copy the sample because its place can be reused after 'tail' is moved*/
+        sample = q->buf[q->tail];
+        next = (q->tail + 1) % LV_DISPI_QUEUE_SIZE;
+
+        /*Save the pressed samples for the drag throw. Start again at a new press.*/
+        if(sample.pressed != false) {
+            if(q->last.pressed == false) q->hist_cnt = 0;
+            q->hist[q->hist_next] = sample;
+            q->hist_next = (q->hist_next + 1) % LV_DISPI_HIST_NUM;
+            if(q->hist_cnt < LV_DISPI_HIST_NUM) q->hist_cnt ++;
+        }
 
-    /*If reset query occurred in this round then set a flag to 
-     * ask the dispis to reset themself in the next round  */
-    if(lv_dispi_reset_qry != false) {
-        lv_dispi_reset_qry = false;
-        lv_dispi_reset_now = true;
-    } 
-    /*If now a reset occurred then clear the flag*/
-    else if (lv_dispi_reset_now != false){
-        lv_dispi_reset_now = false;
+        q->last = sample;
+        LV_DISPI_ATOMIC_STORE(q->tail, next);
+
+        /*Process the last sample of the same state*/
+        head = LV_DISPI_ATOMIC_LOAD(q->head);
+        if(next == head || q->buf[next].pressed != sample.pressed) {
+            if(sample.pressed == false) dispi_queue_vect(q, dispi_p);
+            dispi_p->pressed = sample.pressed;
+            dispi_proc_point(dispi_p, sample.x, sample.y);
+            proc = true;
+        }
+    }
+
+    /*Without new samples the device is still in the last state*/
+    if(proc == false) {
+        dispi_p->pressed = q->last.pressed;
+        dispi_proc_point(dispi_p, q->last.x, q->last.y);
+    }
+}
+
+/**
+ * Calculate the vector of a display input from the recent pressed samples before a release.
+ * It is the movement in LV_DISPI_READ_PERIOD like in the polled case.
+ * @param q pointer to the queue of the input device
+ * @param dispi_p pointer to the display input
+ */
+static void dispi_queue_vect(lv_dispi_queue_t * q, lv_dispi_t * dispi_p)
+{
+    if(q->hist_cnt < 2 || dispi_p->drag_in_prog == 0) return;
+
+    const lv_dispi_sample_t * newest = &q->hist[(q->hist_next + LV_DISPI_HIST_NUM - 1) % LV_DISPI_HIST_NUM];
+    const lv_dispi_sample_t * oldest = newest;
+    const lv_dispi_sample_t * s;
+    uint8_t i;
+
+    /*Find the oldest sample in the time window*/
+    for(i = 1; i < q->hist_cnt; i++) {
+        s = &q->hist[(q->hist_next + LV_DISPI_HIST_NUM - 1 - i) % LV_DISPI_HIST_NUM];
+        if(newest->time - s->time > LV_DISPI_HIST_TIME) break;
+        oldest = s;
     }
+
+    uint32_t t = newest->time - oldest->time;
+    if(t == 0) return;
+
+    dispi_p->vect.x = (int32_t)(newest->x - oldest->x) * LV_DISPI_READ_PERIOD / (int32_t) t;
+    dispi_p->vect.y = (int32_t)(newest->y - oldest->y) * LV_DISPI_READ_PERIOD / (int32_t) t;
+#if LV_ANTIALIAS != 0 && LV_VDB_SIZE != 0
+    dispi_p->vect.x *= LV_DOWNSCALE;
+    dispi_p->vect.y *= LV_DOWNSCALE;
+#endif
 }
+#endif
 
 /**
  * Process new points by a display input. dispi_p->pressed has to be set
@@ -225,11 +493,19 @@ static void dispi_proc_press(lv_dispi_t * dispi_p)
 
     /*If there is no last object then search*/
     if(dispi_p->act_obj == NULL) {
+#if LV_DISPI_HIT_GRID != 0
+        pr_obj = dispi_hit_search(dispi_p);
+#else
         pr_obj = dispi_search_obj(dispi_p, lv_scr_act());
+#endif
     }
     /*If there is last object but it is not dragged also search*/
     else if(dispi_p->drag_in_prog == 0) {/*Now act_obj != NULL*/
+#if LV_DISPI_HIT_GRID != 0
+        pr_obj = dispi_hit_search(dispi_p);
+#else
         pr_obj = dispi_search_obj(dispi_p, lv_scr_act());
+#endif
     }
     /*If a dragable object was the last then keep it*/
     else {
@@ -272,6 +548,9 @@ static void dispi_proc_press(lv_dispi_t * dispi_p)
             	/*After list change it will be the new head*/
                 ll_chg_list(&par->child_ll, &par->child_ll, last_top);
                 lv_obj_inv(last_top);
+#if LV_DISPI_HIT_GRID != 0
+                lv_dispi_hit_inv(last_top);
+#endif
             }
 
             /*Send a signal about the press*/
@@ -293,6 +572,9 @@ static void dispi_proc_press(lv_dispi_t * dispi_p)
         if(dispi_p->act_obj != NULL) {
             dispi_p->act_obj->signal_f(dispi_p->act_obj, LV_SIGNAL_PRESSING, dispi_p);
 
+            /*The object can be deleted in the signal function*/
+            if(dispi_p->act_obj == NULL) return;
+
             dispi_drag(dispi_p);
         
             /*If there is no drag then check for long press time*/
@@ -393,6 +675,226 @@ static lv_obj_t * dispi_search_obj(const lv_dispi_t * dispi_p, lv_obj_t * obj)
     return found_p;    
 }
 
+#if LV_DISPI_HIT_GRID != 0
+/**
+ * Search the most top, clickable object on the last point of a display input
+ * in the index of the active screen. Gives the same result as 'dispi_search_obj'.
+ * @param dispi_p pointer to a display input
+ * @return pointer to the found object or NULL if there was no suitable object
+ */
+static lv_obj_t * dispi_hit_search(const lv_dispi_t * dispi_p)
+{
+    /*Rebuild or update the index if required. Search in the tree if it is not possible.*/
+    if(hit_valid == false || hit_scr != lv_scr_act()) {
+        if(dispi_hit_refr() == false) return dispi_search_obj(dispi_p, lv_scr_act());
+    } else if(hit_moved != NULL) {
+        if(dispi_hit_upd(hit_moved) == false) return dispi_search_obj(dispi_p, lv_scr_act());
+    }
+
+    const point_t * p = &dispi_p->act_point;
+    if(p->x < 0 || p->x >= LV_HOR_RES || p->y < 0 || p->y >= LV_VER_RES) return NULL;
+
+    /*Check only the objects of the cell of the point. They are ordered like in 'dispi_search_obj'*/
+    uint16_t cell = (p->y / LV_DISPI_HIT_CELL_H) * LV_DISPI_HIT_GRID + p->x / LV_DISPI_HIT_CELL_W;
+    uint32_t i;
+    lv_dispi_hit_t * hit;
+    for(i = hit_cell_start[cell]; i < hit_cell_start[cell + 1]; i++) {
+        hit = &hit_a[hit_cell_a[i]];
+        if(area_is_point_on(&hit->area, p) != false) return hit->obj;
+    }
+
+    return NULL;
+}
+
+/**
+ * Rebuild the index of the clickable objects of the active screen
+ * @return true: the index is valid, false: there was no enough memory or too many objects
+ */
+static bool dispi_hit_refr(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    area_t scr_area;
+    area_set(&scr_area, 0, 0, LV_HOR_RES - 1, LV_VER_RES - 1);
+
+    hit_valid = false;
+    hit_moved = NULL;
+
+    /*Count the clickable objects. 'hit_cell_a' can store 16 bit indexes only.*/
+    uint32_t num = dispi_hit_collect(scr, &scr_area, 0, NULL);
+    if(num > UINT16_MAX) return false;
+
+    /*Allocate more memory only if the objects don't fit*/
+    if(num > hit_a_size) {
+        if(hit_a != NULL) dm_free(hit_a);
+        hit_a = dm_alloc(num * sizeof(lv_dispi_hit_t));
+        hit_a_size = hit_a != NULL ? num : 0;
+        if(hit_a == NULL) return false;
+    }
+
+    /*Save the objects (the display's area is the start to crop them)*/
+    hit_num = dispi_hit_collect(scr, &scr_area, 0, hit_a);
+    if(dispi_hit_cell_refr() == false) return false;
+
+    hit_scr = scr;
+    hit_valid = true;
+
+    return true;
+}
+
+/**
+ * Update the entries of a moved object and its children only
+ * @param obj pointer to an object on the indexed screen
+ * @return true: the index is valid, false: there was no enough memory or too many objects
+ */
+static bool dispi_hit_upd(lv_obj_t * obj)
+{
+    hit_moved = NULL;
+
+    /*Find the old entries. The object and its children are after each other in 'hit_a'*/
+    uint32_t first = 0;
+    uint32_t old_num = 0;
+    uint32_t i;
+    for(i = 0; i < hit_num; i++) {
+        if(dispi_hit_is_in(hit_a[i].obj, obj) != false) {
+            if(old_num == 0) first = i;
+            old_num ++;
+        } else if(old_num != 0) {
+            break;
+        }
+    }
+
+    /*Without old entries the place of the new ones is unknown*/
+    if(old_num == 0) return dispi_hit_refr();
+
+    /*Crop with the parents like 'dispi_hit_refr'*/
+    area_t par_area;
+    area_set(&par_area, 0, 0, LV_HOR_RES - 1, LV_VER_RES - 1);
+    bool par_ok = true;
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    while(par != NULL && par_ok != false) {
+        par_ok = area_union(&par_area, &par_area, &par->cords);
+        par = lv_obj_get_parent(par);
+    }
+
+    uint32_t new_num = par_ok != false ? dispi_hit_collect(obj, &par_area, 0, NULL) : 0;
+    if(new_num != old_num) {
+        if(hit_num - old_num + new_num > hit_a_size) return dispi_hit_refr();
+
+        /*Move the next entries to make the place of the new ones exact*/
+        memmove(&hit_a[first + new_num], &hit_a[first + old_num],
+                (hit_num - first - old_num) * sizeof(lv_dispi_hit_t));
+        hit_num = hit_num - old_num + new_num;
+    }
+
+    if(new_num != 0) dispi_hit_collect(obj, &par_area, first, hit_a);
+
+    if(dispi_hit_cell_refr() == false) {
+        hit_valid = false;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Group the entries of 'hit_a' by cells into 'hit_cell_a'
+ * @return true: ready, false: there was no enough memory
+ */
+static bool dispi_hit_cell_refr(void)
+{
+    /*Count the objects in the cells*/
+    uint32_t h;
+    uint16_t cell;
+    cord_t cx, cy;
+    memset(hit_cell_start, 0, sizeof(hit_cell_start));
+    for(h = 0; h < hit_num; h++) {
+        for(cy = hit_a[h].area.y1 / LV_DISPI_HIT_CELL_H; cy <= hit_a[h].area.y2 / LV_DISPI_HIT_CELL_H; cy++) {
+            for(cx = hit_a[h].area.x1 / LV_DISPI_HIT_CELL_W; cx <= hit_a[h].area.x2 / LV_DISPI_HIT_CELL_W; cx++) {
+                hit_cell_start[cy * LV_DISPI_HIT_GRID + cx + 1] ++;
+            }
+        }
+    }
+
+    for(cell = 0; cell < LV_DISPI_HIT_CELL_NUM; cell++) {
+        hit_cell_start[cell + 1] += hit_cell_start[cell];
+    }
+
+    /*Allocate more memory only if the indexes don't fit*/
+    uint32_t cell_num = hit_cell_start[LV_DISPI_HIT_CELL_NUM];
+    if(cell_num > hit_cell_size) {
+        if(hit_cell_a != NULL) dm_free(hit_cell_a);
+        hit_cell_a = dm_alloc(cell_num * sizeof(uint16_t));
+        hit_cell_size = hit_cell_a != NULL ? cell_num : 0;
+        if(hit_cell_a == NULL) return false;
+    }
+
+    /*Add the objects to the cells keeping their order*/
+    uint32_t cell_cnt[LV_DISPI_HIT_CELL_NUM];
+    memcpy(cell_cnt, hit_cell_start, sizeof(cell_cnt));
+    for(h = 0; h < hit_num; h++) {
+        for(cy = hit_a[h].area.y1 / LV_DISPI_HIT_CELL_H; cy <= hit_a[h].area.y2 / LV_DISPI_HIT_CELL_H; cy++) {
+            for(cx = hit_a[h].area.x1 / LV_DISPI_HIT_CELL_W; cx <= hit_a[h].area.x2 / LV_DISPI_HIT_CELL_W; cx++) {
+                cell = cy * LV_DISPI_HIT_GRID + cx;
+                hit_cell_a[cell_cnt[cell]] = h;
+                cell_cnt[cell] ++;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Collect the clickable objects in the order of 'dispi_search_obj':
+ * the children (the top first) before their parent. (Called recursively)
+ * @param obj pointer to an object
+ * @param par_area_p the clickable area of the parent
+ * @param hit_cnt number of already collected objects
+ * @param buf save the objects here from the 'hit_cnt' index (NULL: only count them)
+ * @return number of collected objects after 'obj' and its children.
+ */
+static uint32_t dispi_hit_collect(lv_obj_t * obj, const area_t * par_area_p, uint32_t hit_cnt, lv_dispi_hit_t * buf)
+{
+    /*The hidden objects and their children are not clickable*/
+    if(lv_obj_get_hidden(obj) != false) return hit_cnt;
+
+    /*Only the part on the parents can be pressed*/
+    area_t act_area;
+    if(area_union(&act_area, par_area_p, &obj->cords) == false) return hit_cnt;
+
+    lv_obj_t * i;
+    LL_READ(obj->child_ll, i) {
+        hit_cnt = dispi_hit_collect(i, &act_area, hit_cnt, buf);
+    }
+
+    if(lv_obj_get_click(obj) != false) {
+        if(buf != NULL) {
+            buf[hit_cnt].obj = obj;
+            area_cpy(&buf[hit_cnt].area, &act_area);
+        }
+        hit_cnt ++;
+    }
+
+    return hit_cnt;
+}
+
+/**
+ * Check whether an object is an other object or its child
+ * @param obj pointer to an object
+ * @param par pointer to the possible parent
+ * @return true: 'obj' is 'par' or it is on 'par'
+ */
+static bool dispi_hit_is_in(lv_obj_t * obj, lv_obj_t * par)
+{
+    while(obj != NULL) {
+        if(obj == par) return true;
+        obj = lv_obj_get_parent(obj);
+    }
+
+    return false;
+}
+#endif
+
 /**
  * Handle the dragging of dispi_p->act_obj
  * @param dispi_p pointer to a display input
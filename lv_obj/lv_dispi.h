@@ -15,6 +15,14 @@ extern "C" {
  *********************/
 #include "lv_obj.h"
 
+#ifndef LV_DISPI_HIT_GRID
+#define LV_DISPI_HIT_GRID       0
+#endif
+
+#ifndef LV_DISPI_QUEUE_SIZE
+#define LV_DISPI_QUEUE_SIZE     0
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -59,6 +67,12 @@ typedef lv_action_res_t ( * lv_action_t) (struct __LV_OBJ_T * obj, lv_dispi_t *
  */
 void lv_dispi_init(void);
 
+/**
+ * Read and process the display inputs once.
+ * Called periodically by the display input task or by the frame task (see LV_REFR_FRAME_SYNC)
+ */
+void lv_dispi_proc(void);
+
 /**
  * Get an array with all the display inputs. Contains (INDEV_NUM elements)
  * @return pointer to a an lv_dispi_t array.
@@ -103,6 +117,36 @@ void lv_dispi_get_vect(lv_dispi_t * dispi, point_t * point);
  */
 void lv_dispi_wait_release(lv_dispi_t * dispi);
 
+#if LV_DISPI_QUEUE_SIZE != 0
+/**
+ * Push a sample of an input device into its queue. Can be called from an interrupt or
+ * an other thread (one caller per input device). After the first sample the device
+ * is not read with 'indev_get' anymore.
+ * @param indev_id index of the input device (< INDEV_NUM)
+ * @param pressed true: the input device is pressed
+ * @param x x coordinate of the point
+ * @param y y coordinate of the point
+ * @return true: the sample is saved, false: the queue is full, the sample is lost
+ */
+bool lv_dispi_push(uint8_t indev_id, bool pressed, cord_t x, cord_t y);
+#endif
+
+#if LV_DISPI_HIT_GRID != 0
+/**
+ * Mark the index of the clickable objects as outdated.
+ * Has to be called when the hierarchy or the clickable/hidden attributes of an object change.
+ * @param obj pointer to the changed object. Ignored if it is not on the indexed screen.
+ */
+void lv_dispi_hit_inv(lv_obj_t * obj);
+
+/**
+ * Tell the index that the coordinates of an object are changed.
+ * Only the entries of the object and its children will be updated before the next search.
+ * @param obj pointer to the moved or resized object. Ignored if it is not on the indexed screen.
+ */
+void lv_dispi_hit_move(lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
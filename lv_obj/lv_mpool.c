@@ -0,0 +1,273 @@
+/**
+ * @file lv_mpool.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_mpool.h"
+
+#if LV_MPOOL_BLOCK_NUM != 0
+
+#include <stddef.h>
+#include <string.h>
+#include "misc/mem/dyn_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_MPOOL_CLASS_NUM  (sizeof(class_size) / sizeof(class_size[0]))
+#define LV_MPOOL_SLAB_SIZE  ((sizeof(lv_mpool_slab_t) + 7) & ~7)  /*Size of a slab header rounded up to 8*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A slab: 'LV_MPOOL_BLOCK_NUM' blocks of the same size after this header*/
+typedef struct _lv_mpool_slab_t
+{
+    struct _lv_mpool_slab_t * prev;     /*Previous slab of the class with free blocks*/
+    struct _lv_mpool_slab_t * next;     /*Next slab of the class with free blocks*/
+    void * free_p;                      /*The first free block (the free blocks store the next free block)*/
+    uint16_t used;                      /*Number of used blocks*/
+    uint8_t cls;                        /*Index in 'class_size'*/
+}lv_mpool_slab_t;
+
+/*Header before every block. 8 bytes on 32 and 64 bit too to keep the alignment of the blocks*/
+typedef union
+{
+    lv_mpool_slab_t * slab;     /*The slab of the block (NULL: allocated with 'dm_alloc')*/
+    uint64_t align;             /*Not used. Only to make the header 8 bytes*/
+}lv_mpool_hdr_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_mpool_slab_t * lv_mpool_slab_create(uint8_t cls);
+static void lv_mpool_slab_unlink(lv_mpool_slab_t * slab);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t class_size[] = {16, 32, 64, 128};        /*Block sizes. Multiple of 8 to keep the alignment*/
+static lv_mpool_slab_t * partial_a[LV_MPOOL_CLASS_NUM];         /*The slabs with free blocks per class*/
+static uint16_t slab_cnt;
+static uint16_t block_used_cnt;
+static uint16_t block_free_cnt;
+static uint16_t large_cnt;
+static uint32_t pool_size;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the memory pools
+ */
+void lv_mpool_init(void)
+{
+    memset(partial_a, 0, sizeof(partial_a));
+    slab_cnt = 0;
+    block_used_cnt = 0;
+    block_free_cnt = 0;
+    large_cnt = 0;
+    pool_size = 0;
+}
+
+/**
+ * Allocate a memory block from the smallest pool where it fits.
+ * The too large sizes are allocated with 'dm_alloc'.
+ * The blocks are 8 byte aligned if 'dm_alloc' gives 8 byte aligned memory.
+ * @param size size of the memory in bytes
+ * @return pointer to the allocated memory or NULL if there is no enough memory
+ */
+void * lv_mpool_alloc(uint32_t size)
+{
+    lv_mpool_hdr_t * hdr;
+
+    /*Find the smallest class*/
+    uint8_t cls;
+    for(cls = 0; cls < LV_MPOOL_CLASS_NUM; cls++) {
+        if(size <= class_size[cls]) break;
+    }
+
+    /*Too large for the pools*/
+    if(cls == LV_MPOOL_CLASS_NUM) {
+        hdr = dm_alloc(sizeof(lv_mpool_hdr_t) + size);
+        if(hdr == NULL) return NULL;
+        hdr->slab = NULL;
+        large_cnt ++;
+        return (uint8_t *) hdr + sizeof(lv_mpool_hdr_t);
+    }
+
+    lv_mpool_slab_t * slab = partial_a[cls];
+    if(slab == NULL) {
+        slab = lv_mpool_slab_create(cls);
+        if(slab == NULL) return NULL;
+    }
+
+    /*Take the first free block*/
+    hdr = slab->free_p;
+    slab->free_p = *((void **)((uint8_t *) hdr + sizeof(lv_mpool_hdr_t)));
+    hdr->slab = slab;
+    slab->used ++;
+    block_used_cnt ++;
+    block_free_cnt --;
+
+    /*A full slab has nothing to give*/
+    if(slab->free_p == NULL) lv_mpool_slab_unlink(slab);
+
+    return (uint8_t *) hdr + sizeof(lv_mpool_hdr_t);
+}
+
+/**
+ * Reallocate a memory block allocated with 'lv_mpool_alloc'.
+ * The block remains in place if the new size fits into it.
+ * @param data_p pointer to the memory block (NULL to allocate a new)
+ * @param size new size of the memory in bytes
+ * @return pointer to the reallocated memory or NULL if there is no enough memory
+ */
+void * lv_mpool_realloc(void * data_p, uint32_t size)
+{
+    if(data_p == NULL) return lv_mpool_alloc(size);
+
+    lv_mpool_hdr_t * hdr = (lv_mpool_hdr_t *)((uint8_t *) data_p - sizeof(lv_mpool_hdr_t));
+
+    /*The large blocks are simply reallocated*/
+    if(hdr->slab == NULL) {
+        hdr = dm_realloc(hdr, sizeof(lv_mpool_hdr_t) + size);
+        if(hdr == NULL) return NULL;
+        return (uint8_t *) hdr + sizeof(lv_mpool_hdr_t);
+    }
+
+    uint16_t block_size = class_size[hdr->slab->cls];
+    if(size <= block_size) return data_p;
+
+    void * new_p = lv_mpool_alloc(size);
+    if(new_p == NULL) return NULL;
+
+    memcpy(new_p, data_p, block_size);
+    lv_mpool_free(data_p);
+
+    return new_p;
+}
+
+/**
+ * Free a memory block allocated with 'lv_mpool_alloc'
+ * @param data_p pointer to the memory block
+ */
+void lv_mpool_free(void * data_p)
+{
+    if(data_p == NULL) return;
+
+    lv_mpool_hdr_t * hdr = (lv_mpool_hdr_t *)((uint8_t *) data_p - sizeof(lv_mpool_hdr_t));
+    lv_mpool_slab_t * slab = hdr->slab;
+
+    if(slab == NULL) {
+        large_cnt --;
+        dm_free(hdr);
+        return;
+    }
+
+    /*A full slab has a free block again*/
+    if(slab->free_p == NULL) {
+        slab->prev = NULL;
+        slab->next = partial_a[slab->cls];
+        if(slab->next != NULL) slab->next->prev = slab;
+        partial_a[slab->cls] = slab;
+    }
+
+    *((void **) data_p) = slab->free_p;
+    slab->free_p = hdr;
+    slab->used --;
+    block_used_cnt --;
+    block_free_cnt ++;
+
+    /*Free the empty slab, but keep one per class to avoid allocating it again and again*/
+    if(slab->used == 0 && (partial_a[slab->cls] != slab || slab->next != NULL)) {
+        lv_mpool_slab_unlink(slab);
+        slab_cnt --;
+        block_free_cnt -= LV_MPOOL_BLOCK_NUM;
+        pool_size -= LV_MPOOL_SLAB_SIZE +
+                     (uint32_t) LV_MPOOL_BLOCK_NUM * (sizeof(lv_mpool_hdr_t) + class_size[slab->cls]);
+        dm_free(slab);
+    }
+}
+
+/**
+ * Get the statistics of the pools
+ * @param stat pointer to a 'lv_mpool_stat_t' variable to store the result
+ */
+void lv_mpool_get_stat(lv_mpool_stat_t * stat)
+{
+    stat->size = pool_size;
+    stat->slab_num = slab_cnt;
+    stat->block_used = block_used_cnt;
+    stat->block_free = block_free_cnt;
+    stat->large_num = large_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Allocate a new slab with only free blocks and add it to the slabs with free blocks
+ * @param cls index of the class in 'class_size'
+ * @return pointer to the new slab or NULL if there is no enough memory
+ */
+static lv_mpool_slab_t * lv_mpool_slab_create(uint8_t cls)
+{
+    uint32_t block_size = sizeof(lv_mpool_hdr_t) + class_size[cls];
+    uint32_t size = LV_MPOOL_SLAB_SIZE + (uint32_t) LV_MPOOL_BLOCK_NUM * block_size;
+
+    lv_mpool_slab_t * slab = dm_alloc(size);
+    if(slab == NULL) return NULL;
+
+    slab->used = 0;
+    slab->cls = cls;
+
+    /*Chain the free blocks*/
+    uint8_t * block_p = (uint8_t *) slab + LV_MPOOL_SLAB_SIZE;
+    uint16_t i;
+    slab->free_p = block_p;
+    for(i = 0; i < LV_MPOOL_BLOCK_NUM - 1; i++) {
+        *((void **)(block_p + sizeof(lv_mpool_hdr_t))) = block_p + block_size;
+        block_p += block_size;
+    }
+    *((void **)(block_p + sizeof(lv_mpool_hdr_t))) = NULL;
+
+    slab->prev = NULL;
+    slab->next = partial_a[cls];
+    if(slab->next != NULL) slab->next->prev = slab;
+    partial_a[cls] = slab;
+
+    slab_cnt ++;
+    block_free_cnt += LV_MPOOL_BLOCK_NUM;
+    pool_size += size;
+
+    return slab;
+}
+
+/**
+ * Remove a slab from the list of the slabs with free blocks
+ * @param slab pointer to a slab in 'partial_a'
+ */
+static void lv_mpool_slab_unlink(lv_mpool_slab_t * slab)
+{
+    if(slab->prev != NULL) slab->prev->next = slab->next;
+    else partial_a[slab->cls] = slab->next;
+
+    if(slab->next != NULL) slab->next->prev = slab->prev;
+
+    slab->prev = NULL;
+    slab->next = NULL;
+}
+
+#endif /*LV_MPOOL_BLOCK_NUM != 0*/
@@ -0,0 +1,92 @@
+/**
+ * @file lv_mpool.h
+ * Memory pools with fixed size blocks for the ext. data of the objects
+ */
+
+#ifndef LV_MPOOL_H
+#define LV_MPOOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_MPOOL_BLOCK_NUM
+#define LV_MPOOL_BLOCK_NUM      0
+#endif
+
+#if LV_MPOOL_BLOCK_NUM != 0
+
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct
+{
+    uint32_t size;          /*Memory allocated for the pools in bytes*/
+    uint16_t slab_num;      /*Number of allocated slabs (LV_MPOOL_BLOCK_NUM blocks each)*/
+    uint16_t block_used;    /*Number of used blocks*/
+    uint16_t block_free;    /*Number of free blocks in the slabs*/
+    uint16_t large_num;     /*Number of too large allocations passed to 'dm_alloc'*/
+}lv_mpool_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the memory pools
+ */
+void lv_mpool_init(void);
+
+/**
+ * Allocate a memory block from the smallest pool where it fits.
+ * The too large sizes are allocated with 'dm_alloc'.
+ * The blocks are 8 byte aligned if 'dm_alloc' gives 8 byte aligned memory.
+ * @param size size of the memory in bytes
+ * @return pointer to the allocated memory or NULL if there is no enough memory
+ */
+void * lv_mpool_alloc(uint32_t size);
+
+/**
+ * Reallocate a memory block allocated with 'lv_mpool_alloc'.
+ * The block remains in place if the new size fits into it.
+ * @param data_p pointer to the memory block (NULL to allocate a new)
+ * @param size new size of the memory in bytes
+ * @return pointer to the reallocated memory or NULL if there is no enough memory
+ */
+void * lv_mpool_realloc(void * data_p, uint32_t size);
+
+/**
+ * Free a memory block allocated with 'lv_mpool_alloc'
+ * @param data_p pointer to the memory block
+ */
+void lv_mpool_free(void * data_p);
+
+/**
+ * Get the statistics of the pools
+ * @param stat pointer to a 'lv_mpool_stat_t' variable to store the result
+ */
+void lv_mpool_get_stat(lv_mpool_stat_t * stat);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_MPOOL_BLOCK_NUM != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_MPOOL_H*/
@@ -14,6 +14,11 @@
 #include "lvgl/lv_obj/lv_refr.h"
 #include "lvgl/lv_app/lv_app.h"
 #include "lvgl/lv_draw/lv_draw_rbasic.h"
+#include "lvgl/lv_draw/lv_gcache.h"
+#include "lvgl/lv_draw/lv_scache.h"
+#include "lvgl/lv_draw/lv_ccache.h"
+#include "lvgl/lv_draw/lv_grad.h"
+#include "lvgl/lv_obj/lv_mpool.h"
 #include "misc/gfx/anim.h"
 #include "hal/indev/indev.h"
 #include <stdint.h>
@@ -26,17 +31,51 @@
 /*********************
  *      DEFINES
  *********************/
+#define LV_OBJ_STYLE_HASH_NUM   32      /*Number of lists in the style index. Must be power of 2*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*An object changed in a batch (see 'lv_obj_batch_start')*/
+typedef struct
+{
+    lv_obj_t * obj;         /*The changed object (NULL if deleted in the batch)*/
+    lv_obj_t * child;       /*The changed child or NULL if more children are changed*/
+    area_t ori;             /*The coordinates when the object was notified last time*/
+    uint8_t cords_chg :1;   /*1: LV_SIGNAL_CORD_CHG has to be sent*/
+    uint8_t child_chg :1;   /*1: LV_SIGNAL_CHILD_CHG has to be sent*/
+    uint8_t inv       :1;   /*1: The object is moved or resized so invalidate its new area at the end*/
+    uint8_t resized   :1;   /*1: The object is resized (not only moved)*/
+}lv_obj_batch_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_obj_pos_child_refr(lv_obj_t * obj, cord_t x_diff, cord_t y_diff);
 static void lv_style_refr_core(void * style_p, lv_obj_t * obj);
 static void lv_child_refr_style(lv_obj_t * obj);
+#if LV_OBJ_STYLE_RES != 0
+static void lv_obj_style_res_clr(lv_obj_t * obj);
+#endif
+#if LV_OBJ_STYLE_INDEX != 0
+static void lv_obj_style_index_add(lv_obj_t * obj);
+static void lv_obj_style_index_rem(lv_obj_t * obj);
+static uint8_t lv_obj_style_hash(const lv_style_t * style);
+#endif
 static void lv_obj_del_child(lv_obj_t * obj);
+static void lv_obj_dispi_rem(lv_obj_t * obj);
+static void lv_obj_inv_moved(lv_obj_t * obj);
+#if LV_OBJ_LAYER != 0
+static void lv_obj_inv_layer(lv_obj_t * obj);
+#endif
+static lv_obj_batch_t * lv_obj_batch_find(lv_obj_t * obj);
+static bool lv_obj_batch_save(lv_obj_t * obj, bool resize);
+static bool lv_obj_batch_chg(lv_obj_t * obj);
+static void lv_obj_batch_rem(lv_obj_t * obj);
+#if LV_OBJ_MOVE_COPY != 0
+static bool lv_obj_get_copy_area(lv_obj_t * obj, area_t * area_p);
+#endif
 static bool lv_obj_design(lv_obj_t * obj, const  area_t * mask_p, lv_design_mode_t mode);
 
 /**********************
@@ -45,6 +84,12 @@ static bool lv_obj_design(lv_obj_t * obj, const  area_t * mask_p, lv_design_mode
 static lv_obj_t * def_scr = NULL;
 static lv_obj_t * act_scr = NULL;
 static ll_dsc_t scr_ll;
+static ll_dsc_t batch_ll;       /*The objects changed in the current batch*/
+static uint16_t batch_depth;    /*Number of not finished 'lv_obj_batch_start' calls*/
+static bool batch_send;         /*true: 'lv_obj_batch_end' is sending the saved signals*/
+#if LV_OBJ_STYLE_INDEX != 0
+static lv_obj_t * style_index[LV_OBJ_STYLE_HASH_NUM];  /*Lists of the objects by the hash of their style*/
+#endif
 
 #ifdef LV_IMG_DEF_WALLPAPER
 LV_IMG_DECLARE(LV_IMG_DEF_WALLPAPER);
@@ -74,6 +119,40 @@ void lv_init(void)
     /*Init. the screen refresh system*/
     lv_refr_init();
 
+#if LV_VDB_SIZE != 0 && LV_GCACHE_SIZE != 0
+    /*Init. the glyph cache*/
+    lv_gcache_init();
+#endif
+
+#if LV_SCACHE_SIZE != 0
+    /*Init. the shadow cache*/
+    lv_scache_init();
+#endif
+
+#if LV_CCACHE_SIZE != 0
+    /*Init. the corner cache*/
+    lv_ccache_init();
+#endif
+
+#if LV_GRAD_CACHE_SIZE != 0
+    /*Init. the gradient cache*/
+    lv_grad_init();
+#endif
+
+#if LV_MPOOL_BLOCK_NUM != 0
+    /*Init. the memory pools of the ext. data*/
+    lv_mpool_init();
+#endif
+
+    /*Init. the batched coordinate changes*/
+    ll_init(&batch_ll, sizeof(lv_obj_batch_t));
+    batch_depth = 0;
+    batch_send = false;
+
+#if LV_OBJ_STYLE_INDEX != 0
+    memset(style_index, 0, sizeof(style_index));
+#endif
+
     /*Create the default screen*/
     ll_init(&scr_ll, sizeof(lv_obj_t));
 #ifdef LV_IMG_DEF_WALLPAPER
@@ -132,6 +211,9 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
 
 		/*Set appearance*/
 		new_obj->style_p = lv_style_get(LV_STYLE_SCR, NULL);
+#if LV_OBJ_STYLE_RES != 0
+		new_obj->style_res = NULL;
+#endif
 
 		/*Set virtual functions*/
 		lv_obj_set_signal_f(new_obj, lv_obj_signal);
@@ -155,6 +237,15 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->protect = LV_PROTECT_NONE;
 
 		new_obj->ext = NULL;
+#if LV_OBJ_LAYER != 0
+        new_obj->layer_en = 0;
+        new_obj->layer_valid = 0;
+        new_obj->layer_buf = NULL;
+        new_obj->layer_px = 0;
+#endif
+#if LV_OBJ_MOVE_COPY != 0
+        new_obj->move_copy = 0;
+#endif
 	 }
     /*parent != NULL create normal obj. on a parent*/
     else
@@ -175,6 +266,9 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
 
         /*Set appearance*/
         new_obj->style_p = lv_style_get(LV_STYLE_PLAIN, NULL);
+#if LV_OBJ_STYLE_RES != 0
+        new_obj->style_res = NULL;
+#endif
         
         /*Set virtual functions*/
         lv_obj_set_signal_f(new_obj, lv_obj_signal);
@@ -198,9 +292,22 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->protect = LV_PROTECT_NONE;
         
         new_obj->ext = NULL;
+#if LV_OBJ_LAYER != 0
+        new_obj->layer_en = 0;
+        new_obj->layer_valid = 0;
+        new_obj->layer_buf = NULL;
+        new_obj->layer_px = 0;
+#endif
+#if LV_OBJ_MOVE_COPY != 0
+        new_obj->move_copy = 0;
+#endif
         
     }
 
+#if LV_OBJ_STYLE_INDEX != 0
+    lv_obj_style_index_add(new_obj);
+#endif
+
     if(copy != NULL) {
     	area_cpy(&new_obj->cords, &copy->cords);
     	new_obj->ext_size = copy->ext_size;
@@ -220,13 +327,29 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->hidden = copy->hidden;
         new_obj->top_en = copy->top_en;
         new_obj->protect = copy->protect;
+#if LV_OBJ_LAYER != 0
+        new_obj->layer_en = copy->layer_en;
+#endif
+#if LV_OBJ_MOVE_COPY != 0
+        new_obj->move_copy = copy->move_copy;
+#endif
 
+#if LV_OBJ_STYLE_INDEX != 0
+        lv_obj_style_index_rem(new_obj);
+        new_obj->style_p = copy->style_p;
+        lv_obj_style_index_add(new_obj);
+#else
         new_obj->style_p = copy->style_p;
+#endif
 
     	lv_obj_set_pos(new_obj, lv_obj_get_x(copy), lv_obj_get_y(copy));
     }
 
 
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_inv(new_obj);
+#endif
+
     /*Send a signal to the parent to notify it about the new child*/
     if(parent != NULL) {
         parent->signal_f(parent, LV_SIGNAL_CHILD_CHG, new_obj);
@@ -244,59 +367,19 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
  */
 void lv_obj_del(lv_obj_t * obj)
 {
+    /*Invalidate only 'obj'. The children are on it.*/
     lv_obj_inv(obj);
-    
-    /*Recursively delete the children*/
-    lv_obj_t * i;
-    lv_obj_t * i_next;
-    i = ll_get_head(&(obj->child_ll));
-    while(i != NULL) {
-        /*Get the next object before delete this*/
-        i_next = ll_get_next(&(obj->child_ll), i);
-        
-        /*Call the recursive del to the child too*/
-        lv_obj_del_child(i);
-        
-        /*Set i to the next node*/
-        i = i_next;
-    }
-    
-    /*Remove the animations from this object*/
-    anim_del(obj, NULL);
 
-    /*Remove the object from parent's children list*/
+    /*Forget the deleted objects in the display inputs before freeing them*/
+    lv_obj_dispi_rem(obj);
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_inv(obj);
+#endif
+
     lv_obj_t * par = lv_obj_get_parent(obj);
-    if(par == NULL) { /*It is a screen*/
-    	ll_rem(&scr_ll, obj);
-    } else {
-    	ll_rem(&(par->child_ll), obj);
-    }
 
-    /* All children deleted.
-     * Now clean up the object specific data*/
-    obj->signal_f(obj, LV_SIGNAL_CLEANUP, NULL);
-    
-    /*Delete the base objects*/
-    if(obj->ext != NULL)  dm_free(obj->ext);
-    dm_free(obj); /*Free the object itself*/
-    
-    /* Reset all display input (dispi) if
-     * the currently pressed object is deleted too*/
-    lv_dispi_t * dispi_array = lv_dispi_get_array();
-    lv_obj_t * dpar;
-    uint8_t d;
-    for(d = 0; d < INDEV_NUM; d++) {
-        dpar = obj;
-        while(dpar != NULL) {
-            if(dispi_array[d].act_obj == dpar ||
-               dispi_array[d].last_obj == dpar) {
-                lv_dispi_reset();
-                break;
-            } else {
-                dpar = lv_obj_get_parent(dpar);
-            }
-        }
-    }
+    /*Delete the object and its children in one traversal*/
+    lv_obj_del_child(obj);
 
     /*Send a signal to the parent to notify it about the child delete*/
     if(par != NULL) {
@@ -341,6 +424,10 @@ bool lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
  */
 void lv_obj_inv(lv_obj_t * obj)
 {
+#if LV_OBJ_LAYER != 0
+    lv_obj_inv_layer(obj);
+#endif
+
     /*Invalidate the object only if it belongs to the 'act_scr'*/
     lv_obj_t * act_scr_p = lv_scr_act();
     if(lv_obj_get_scr(obj) == act_scr_p) {
@@ -368,6 +455,91 @@ void lv_obj_inv(lv_obj_t * obj)
     }
 }
 
+/**
+ * Mark an area of an object as invalid (e.g. a changed part of it) therefore it will be redrawn by 'lv_refr_task'.
+ * Use it instead of 'lv_inv_area' because the layers of the object and its parents are invalidated too.
+ * @param obj pointer to an object
+ * @param area_p the area to redraw (absolute coordinates)
+ */
+void lv_obj_inv_area(lv_obj_t * obj, const area_t * area_p)
+{
+#if LV_OBJ_LAYER != 0
+    lv_obj_inv_layer(obj);
+#endif
+
+    lv_inv_area(area_p);
+}
+
+/**
+ * Start a batch of coordinate changes. Until 'lv_obj_batch_end' the position and size setters
+ * only change the coordinates. The LV_SIGNAL_CORD_CHG and LV_SIGNAL_CHILD_CHG signals are sent
+ * (once per object) and the new areas are invalidated in 'lv_obj_batch_end'.
+ * The batches can be nested.
+ */
+void lv_obj_batch_start(void)
+{
+    batch_depth ++;
+}
+
+/**
+ * Finish a batch of coordinate changes started with 'lv_obj_batch_start'.
+ * Send the saved signals (e.g. to refresh the layouts) and invalidate the changed objects.
+ */
+void lv_obj_batch_end(void)
+{
+    if(batch_depth == 0) return;
+    batch_depth --;
+
+    /* Only the outermost batch sends the signals.
+     * The batches started in the signal functions are sent here too*/
+    if(batch_depth != 0 || batch_send != false) return;
+
+    /* The signal functions work without batch (as normally) except their own batches
+     * (e.g. a layout moves the children in a batch). These objects are added to the list
+     * so repeat until there is no more signal to send.*/
+    batch_send = true;
+    lv_obj_batch_t * b;
+    lv_obj_t * obj;
+    area_t ori;
+    bool sent;
+    do {
+        sent = false;
+
+        /*First notify the objects about their new coordinates*/
+        LL_READ(batch_ll, b) {
+            if(b->obj == NULL || b->cords_chg == 0) continue;
+            obj = b->obj;
+            b->cords_chg = 0;
+            area_cpy(&ori, &b->ori);
+            area_cpy(&b->ori, &obj->cords);
+
+            /*Skip if the object is moved back to its original place*/
+            if(memcmp(&ori, &obj->cords, sizeof(area_t)) == 0) continue;
+
+            obj->signal_f(obj, LV_SIGNAL_CORD_CHG, &ori);
+            sent = true;
+        }
+
+        /*Then the parents about their changed children (once per parent)*/
+        LL_READ(batch_ll, b) {
+            if(b->obj == NULL || b->child_chg == 0) continue;
+            b->child_chg = 0;
+            b->obj->signal_f(b->obj, LV_SIGNAL_CHILD_CHG, b->child);
+            sent = true;
+        }
+    } while(sent != false);
+
+    /*Invalidate the new areas*/
+    LL_READ(batch_ll, b) {
+        if(b->obj == NULL || b->inv == 0) continue;
+        if(b->resized != 0) lv_obj_inv(b->obj);
+        else lv_obj_inv_moved(b->obj);
+    }
+
+    ll_clear(&batch_ll);
+    batch_send = false;
+}
+
 
 /*=====================
  * Setter functions 
@@ -384,6 +556,9 @@ void lv_obj_inv(lv_obj_t * obj)
 void lv_scr_load(lv_obj_t * scr)
 {
     act_scr = scr;
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_inv(scr);
+#endif
     
     lv_obj_inv(act_scr);
 }
@@ -400,6 +575,10 @@ void lv_scr_load(lv_obj_t * scr)
 void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 {
     lv_obj_inv(obj);
+#if LV_DISPI_HIT_GRID != 0
+    /*The original screen*/
+    lv_dispi_hit_inv(obj);
+#endif
     
     point_t old_pos;
     old_pos.x = lv_obj_get_x(obj);
@@ -407,6 +586,14 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     
     ll_chg_list(&obj->par->child_ll, &parent->child_ll, obj);
     obj->par = parent;
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_inv(obj);
+#endif
+
+#if LV_OBJ_STYLE_RES != 0
+    /*The inherited styles can be different with the new parent*/
+    lv_obj_style_res_clr(obj);
+#endif
     lv_obj_set_pos(obj, old_pos.x, old_pos.y);
 
     /*Notify the original parent because one of its children is lost*/
@@ -445,8 +632,16 @@ void lv_obj_set_pos(lv_obj_t * obj, cord_t x, cord_t y)
      * occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
         
-    /*Invalidate the original area*/
-    lv_obj_inv(obj);
+#if LV_OBJ_MOVE_COPY != 0
+    /*If the drawn pixels can be copied do not invalidate the original area*/
+    area_t copy_area;
+    bool copy = false;
+    if(obj->move_copy != 0 && batch_depth == 0) copy = lv_obj_get_copy_area(obj, &copy_area);
+    if(copy == false && lv_obj_batch_save(obj, false) == false) lv_obj_inv_moved(obj);
+#else
+    /*Invalidate the original area (in a batch only at the first change)*/
+    if(lv_obj_batch_save(obj, false) == false) lv_obj_inv_moved(obj);
+#endif
 
     /*Save the original coordinates*/
     area_t ori;
@@ -458,15 +653,33 @@ void lv_obj_set_pos(lv_obj_t * obj, cord_t x, cord_t y)
     obj->cords.y2 += diff.y;
     
     lv_obj_pos_child_refr(obj, diff.x, diff.y);
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_move(obj);
+#endif
     
+    /*In a batch the signals are sent and the new area is invalidated in 'lv_obj_batch_end'*/
+    if(lv_obj_batch_chg(obj) != false) return;
+
     /*Inform the object about its new coordinates*/
     obj->signal_f(obj, LV_SIGNAL_CORD_CHG, &ori);
     
     /*Send a signal to the parent too*/
     par->signal_f(par, LV_SIGNAL_CHILD_CHG, obj);
     
+#if LV_OBJ_MOVE_COPY != 0
+    if(copy != false) {
+        /*Copy the pixels only if the visible area is not changed else redraw the original area too*/
+        area_t copy_area_new;
+        if(lv_obj_get_copy_area(obj, &copy_area_new) != false &&
+           memcmp(&copy_area, &copy_area_new, sizeof(area_t)) == 0) {
+            if(lv_refr_move_area(&copy_area, diff.x, diff.y) != false) return;
+        }
+        lv_inv_area(&copy_area);
+    }
+#endif
+
     /*Invalidate the new area*/
-    lv_obj_inv(obj);
+    lv_obj_inv_moved(obj);
 }
 
 /**
@@ -539,8 +752,8 @@ void lv_obj_set_size(lv_obj_t * obj, cord_t w, cord_t h)
 		return;
 	}
 
-    /*Invalidate the original area*/
-    lv_obj_inv(obj);
+    /*Invalidate the original area (in a batch only at the first change)*/
+    if(lv_obj_batch_save(obj, true) == false) lv_obj_inv(obj);
     
     /*Save the original coordinates*/
     area_t ori;
@@ -549,7 +762,12 @@ void lv_obj_set_size(lv_obj_t * obj, cord_t w, cord_t h)
     //Set the length and height
     obj->cords.x2 = obj->cords.x1 + w - 1;
     obj->cords.y2 = obj->cords.y1 + h - 1;
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_move(obj);
+#endif
 
+    /*In a batch the signals are sent and the new area is invalidated in 'lv_obj_batch_end'*/
+    if(lv_obj_batch_chg(obj) != false) return;
 
     /*Send a signal to the object with its new coordinates*/
     obj->signal_f(obj, LV_SIGNAL_CORD_CHG, &ori);
@@ -573,6 +791,42 @@ void lv_obj_set_size_us(lv_obj_t * obj, cord_t w, cord_t h)
 	lv_obj_set_size(obj, w * LV_DOWNSCALE, h * LV_DOWNSCALE);
 }
 
+/**
+ * Set the absolute coordinates of an object without moving its children (e.g. to fit to the children)
+ * @param obj pointer to an object
+ * @param cords_p pointer to the new coordinates
+ */
+void lv_obj_set_cords(lv_obj_t * obj, const area_t * cords_p)
+{
+    /*Do nothing if the coordinates are not changed*/
+    if(memcmp(&obj->cords, cords_p, sizeof(area_t)) == 0) return;
+
+    /*Invalidate the original area (in a batch only at the first change)*/
+    if(lv_obj_batch_save(obj, true) == false) lv_obj_inv(obj);
+
+    /*Save the original coordinates*/
+    area_t ori;
+    lv_obj_get_cords(obj, &ori);
+
+    area_cpy(&obj->cords, cords_p);
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_move(obj);
+#endif
+
+    /*In a batch the signals are sent and the new area is invalidated in 'lv_obj_batch_end'*/
+    if(lv_obj_batch_chg(obj) != false) return;
+
+    /*Invalidate the new area*/
+    lv_obj_inv(obj);
+
+    /*Notify the object about its new coordinates*/
+    obj->signal_f(obj, LV_SIGNAL_CORD_CHG, &ori);
+
+    /*Inform the parent about the new coordinates*/
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par != NULL) par->signal_f(par, LV_SIGNAL_CHILD_CHG, obj);
+}
+
 /**
  * Set the width of an object
  * @param obj pointer to an object
@@ -787,7 +1041,18 @@ void lv_obj_set_ext_size(lv_obj_t * obj, cord_t ext_size)
  */
 void lv_obj_set_style(lv_obj_t * obj, lv_style_t * style)
 {
+#if LV_OBJ_STYLE_INDEX != 0
+    lv_obj_style_index_rem(obj);
     obj->style_p = style;
+    lv_obj_style_index_add(obj);
+#else
+    obj->style_p = style;
+#endif
+
+#if LV_OBJ_STYLE_RES != 0
+    /*The inherited styles has to be resolved again*/
+    lv_obj_style_res_clr(obj);
+#endif
 
     /*Send a signal about style change to every children with NULL style*/
     lv_child_refr_style(obj);
@@ -814,6 +1079,28 @@ void lv_obj_refr_style(lv_obj_t * obj)
 void lv_style_refr_objs(void * style)
 {
     lv_obj_t * i;
+
+#if LV_OBJ_STYLE_INDEX != 0
+    /*Notify only the objects in the list of the style's hash*/
+    if(style != NULL) {
+        lv_obj_t * i_next;
+        i = style_index[lv_obj_style_hash(style)];
+        while(i != NULL) {
+            /*Get the next object before the signal because the style can be changed in it*/
+            i_next = i->style_next;
+            if(i->style_p == style) {
+#if LV_OBJ_STYLE_RES != 0
+                /*The style can be changed to glass so resolve the inherited styles again*/
+                lv_obj_style_res_clr(i);
+#endif
+                lv_obj_refr_style(i);
+            }
+            i = i_next;
+        }
+        return;
+    }
+#endif
+
     LL_READ(scr_ll, i) {
         lv_style_refr_core(style, i);
     }
@@ -832,6 +1119,9 @@ void lv_style_refr_objs(void * style)
 void lv_obj_set_hidden(lv_obj_t * obj, bool en)
 {
     obj->hidden = en == false ? 0 : 1;
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_inv(obj);
+#endif
     
     lv_obj_t * par = lv_obj_get_parent(obj);
     par->signal_f(par, LV_SIGNAL_CHILD_CHG, obj);
@@ -847,6 +1137,9 @@ void lv_obj_set_hidden(lv_obj_t * obj, bool en)
 void lv_obj_set_click(lv_obj_t * obj, bool en)
 {
     obj->click_en = (en == true ? 1 : 0);
+#if LV_DISPI_HIT_GRID != 0
+    lv_dispi_hit_inv(obj);
+#endif
     
 }
 
@@ -861,6 +1154,46 @@ void lv_obj_set_top(lv_obj_t * obj, bool en)
     obj->top_en= (en == true ? 1 : 0);
 }
 
+#if LV_OBJ_LAYER != 0
+/**
+ * Cache the rendered object and its children in a layer. Until the object or
+ * a child is invalidated (e.g. a style or text change) the layer is simply copied
+ * to the screen instead of drawing the objects again, even if the object is moved.
+ * The layer needs width * height pixels memory. It is used only if the object covers its area
+ * (opaque, not rounded body) else the object is drawn directly. The shadow is always drawn directly.
+ * @param obj pointer to an object
+ * @param en true: enable the layer, false: disable it and free its memory
+ */
+void lv_obj_set_layer(lv_obj_t * obj, bool en)
+{
+    obj->layer_en = (en == true ? 1 : 0);
+    obj->layer_valid = 0;
+
+    if(en == false && obj->layer_buf != NULL) {
+        dm_free(obj->layer_buf);
+        obj->layer_buf = NULL;
+        obj->layer_px = 0;
+    }
+
+    lv_obj_inv(obj);
+}
+#endif
+
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Enable to copy the already drawn pixels on the display when the object is moved
+ * (see 'lv_refr_set_copy_cb') and redraw only the newly exposed parts.
+ * It is used only if the object is opaque and covers the whole visible area of its parents
+ * and no other object is on this area (e.g. the scrollable part of a page).
+ * @param obj pointer to an object
+ * @param en true: enable the copy on move
+ */
+void lv_obj_set_move_copy(lv_obj_t * obj, bool en)
+{
+    obj->move_copy = (en == true ? 1 : 0);
+}
+#endif
+
 /**
  * Enable the dragging of an object
  * @param obj pointer to an object
@@ -946,7 +1279,11 @@ void lv_obj_set_design_f(lv_obj_t * obj, lv_design_f_t fp)
  */
 void * lv_obj_alloc_ext(lv_obj_t * obj, uint16_t ext_size)
 {
+#if LV_MPOOL_BLOCK_NUM != 0
+    obj->ext = lv_mpool_realloc(obj->ext, ext_size);
+#else
     obj->ext = dm_realloc(obj->ext, ext_size); 
+#endif
     
    return (void*)obj->ext;
 }
@@ -1235,16 +1572,33 @@ cord_t lv_obj_get_ext_size(lv_obj_t * obj)
 lv_style_t * lv_obj_get_style(lv_obj_t * obj)
 {
     if(obj->style_p != NULL) return obj->style_p;
-    else {
-        lv_obj_t * par = obj->par;
 
-        while(par != NULL) {
-            if(par->style_p != NULL) {
-                if(par->style_p->glass == 0) return par->style_p;
-            }
-            par = par->par;
+#if LV_OBJ_STYLE_RES != 0
+    if(obj->style_res != NULL) return obj->style_res;
+
+    /* Search the first parent with a not glass style.
+     * A parent with NULL style has the same inherited style (use its saved one)*/
+    lv_obj_t * par = obj->par;
+    while(par != NULL) {
+        if(par->style_p == NULL) {
+            obj->style_res = lv_obj_get_style(par);
+            return obj->style_res;
+        }
+        if(par->style_p->glass == 0) {
+            obj->style_res = par->style_p;
+            return obj->style_res;
         }
+        par = par->par;
     }
+#else
+    lv_obj_t * par = obj->par;
+    while(par != NULL) {
+        if(par->style_p != NULL) {
+            if(par->style_p->glass == 0) return par->style_p;
+        }
+        par = par->par;
+    }
+#endif
 
     /*Never reach this, at least the screen has to be a style*/
     return NULL;
@@ -1284,6 +1638,30 @@ bool lv_obj_get_top(lv_obj_t * obj)
     return obj->top_en == 0 ? false : true;;
 }
 
+#if LV_OBJ_LAYER != 0
+/**
+ * Get whether the object is rendered via a layer
+ * @param obj pointer to an object
+ * @return true: the layer is enabled
+ */
+bool lv_obj_get_layer(lv_obj_t * obj)
+{
+    return obj->layer_en == 0 ? false : true;
+}
+#endif
+
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Get whether the drawn pixels are copied when the object is moved
+ * @param obj pointer to an object
+ * @return true: the copy on move is enabled
+ */
+bool lv_obj_get_move_copy(lv_obj_t * obj)
+{
+    return obj->move_copy == 0 ? false : true;
+}
+#endif
+
 /**
  * Get the drag enable attribute of an object
  * @param obj pointer to an object
@@ -1470,6 +1848,11 @@ static void lv_style_refr_core(void * style_p, lv_obj_t * obj)
 {
     lv_obj_t * i;
     LL_READ(obj->child_ll, i) {
+#if LV_OBJ_STYLE_RES != 0
+        /*The style can be changed to glass so resolve the inherited styles again*/
+        i->style_res = NULL;
+#endif
+
         if(i->style_p == style_p || style_p == NULL) {
             lv_obj_inv(i);
             i->signal_f(i, LV_SIGNAL_STYLE_CHG, NULL);
@@ -1500,12 +1883,87 @@ static void lv_child_refr_style(lv_obj_t * obj)
     lv_obj_refr_style(obj);
 }
 
+#if LV_OBJ_STYLE_RES != 0
+/**
+ * Clear the saved inherited style of an object and its children which can inherit it
+ * @param obj pointer to an object
+ */
+static void lv_obj_style_res_clr(lv_obj_t * obj)
+{
+    obj->style_res = NULL;
+
+    /*The children with own (not glass) style are not affected*/
+    lv_obj_t * i;
+    LL_READ(obj->child_ll, i) {
+        if(i->style_p == NULL || i->style_p->glass != 0) {
+            lv_obj_style_res_clr(i);
+        }
+    }
+}
+#endif
+
+#if LV_OBJ_STYLE_INDEX != 0
 /**
- * Called by 'lv_obj_del' to delete the children objects
+ * Add an object to the style index according to its style
+ * @param obj pointer to an object which is not in the index
+ */
+static void lv_obj_style_index_add(lv_obj_t * obj)
+{
+    obj->style_prev = NULL;
+    obj->style_next = NULL;
+
+    /*The objects with NULL style are not indexed*/
+    if(obj->style_p == NULL) return;
+
+    uint8_t hash = lv_obj_style_hash(obj->style_p);
+    obj->style_next = style_index[hash];
+    if(obj->style_next != NULL) obj->style_next->style_prev = obj;
+    style_index[hash] = obj;
+}
+
+/**
+ * Remove an object from the style index. Has to be called before its style is changed.
+ * @param obj pointer to an object
+ */
+static void lv_obj_style_index_rem(lv_obj_t * obj)
+{
+    if(obj->style_p == NULL) return;
+
+    uint8_t hash = lv_obj_style_hash(obj->style_p);
+    if(obj->style_prev != NULL) obj->style_prev->style_next = obj->style_next;
+    else if(style_index[hash] == obj) style_index[hash] = obj->style_next;
+
+    if(obj->style_next != NULL) obj->style_next->style_prev = obj->style_prev;
+
+    obj->style_prev = NULL;
+    obj->style_next = NULL;
+}
+
+/**
+ * Get the index of the list of a style in the style index
+ * @param style pointer to a style
+ * @return index in 'style_index'
+ */
+static uint8_t lv_obj_style_hash(const lv_style_t * style)
+{
+    uintptr_t h = (uintptr_t) style;
+    h = (h >> 3) ^ (h >> 8);
+    return h & (LV_OBJ_STYLE_HASH_NUM - 1);
+}
+#endif
+
+/**
+ * Called by 'lv_obj_del' to delete an object and its children.
+ * It doesn't invalidate and doesn't check the display inputs ('lv_obj_del' does it once).
  * @param obj pointer to an object (all of its children will be deleted)
  */
 static void lv_obj_del_child(lv_obj_t * obj)
 {
+   lv_obj_batch_rem(obj);
+#if LV_OBJ_STYLE_INDEX != 0
+   lv_obj_style_index_rem(obj);
+#endif
+
    lv_obj_t * i;
    lv_obj_t * i_next;
    i = ll_get_head(&(obj->child_ll));
@@ -1525,15 +1983,244 @@ static void lv_obj_del_child(lv_obj_t * obj)
 
    /*Remove the object from parent's children list*/
    lv_obj_t * par = lv_obj_get_parent(obj);
-
-   ll_rem(&(par->child_ll), obj);
+   if(par == NULL) { /*It is a screen*/
+       ll_rem(&scr_ll, obj);
+   } else {
+       ll_rem(&(par->child_ll), obj);
+   }
 
    /* All children deleted.
     * Now clean up the object specific data*/
    obj->signal_f(obj, LV_SIGNAL_CLEANUP, NULL);
 
    /*Delete the base objects*/
+#if LV_MPOOL_BLOCK_NUM != 0
+   if(obj->ext != NULL)  lv_mpool_free(obj->ext);
+#else
    if(obj->ext != NULL)  dm_free(obj->ext);
+#endif
+#if LV_OBJ_LAYER != 0
+   if(obj->layer_buf != NULL) dm_free(obj->layer_buf);
+#endif
    dm_free(obj); /*Free the object itself*/
 
 }
+
+/**
+ * Reset the display inputs if their pressed or last object is 'obj' or one of its children.
+ * The references are cleared immediately to not use them after 'obj' is deleted.
+ * @param obj pointer to an object to delete
+ */
+static void lv_obj_dispi_rem(lv_obj_t * obj)
+{
+    lv_dispi_t * dispi_array = lv_dispi_get_array();
+    lv_obj_t * act_par;
+    lv_obj_t * last_par;
+    uint8_t d;
+    for(d = 0; d < INDEV_NUM; d++) {
+        /*Go up from the referenced objects to see whether they are on 'obj'*/
+        act_par = dispi_array[d].act_obj;
+        while(act_par != NULL && act_par != obj) act_par = lv_obj_get_parent(act_par);
+
+        last_par = dispi_array[d].last_obj;
+        while(last_par != NULL && last_par != obj) last_par = lv_obj_get_parent(last_par);
+
+        if(act_par != NULL || last_par != NULL) {
+            dispi_array[d].act_obj = NULL;
+            dispi_array[d].last_obj = NULL;
+            lv_dispi_reset();
+        }
+    }
+}
+
+/**
+ * Get the batch entry of an object. Add a new entry if the object is not in the batch yet.
+ * @param obj pointer to an object
+ * @return pointer to the batch entry of 'obj'
+ */
+static lv_obj_batch_t * lv_obj_batch_find(lv_obj_t * obj)
+{
+    lv_obj_batch_t * b;
+    LL_READ(batch_ll, b) {
+        if(b->obj == obj) return b;
+    }
+
+    b = ll_ins_tail(&batch_ll);
+    dm_assert(b);
+    b->obj = obj;
+    b->child = NULL;
+    area_cpy(&b->ori, &obj->cords);
+    b->cords_chg = 0;
+    b->child_chg = 0;
+    b->inv = 0;
+    b->resized = 0;
+
+    return b;
+}
+
+/**
+ * Called before the coordinates of an object are changed.
+ * In a batch invalidate the original area only at the first change.
+ * @param obj pointer to an object
+ * @param resize true: the size is changed too (not only the position)
+ * @return true: the change is batched; false: no batch, handle the change normally
+ */
+static bool lv_obj_batch_save(lv_obj_t * obj, bool resize)
+{
+    if(batch_depth == 0) return false;
+
+    lv_obj_batch_t * b = lv_obj_batch_find(obj);
+
+    /*Save the coordinates if it was notified since the last change*/
+    if(b->cords_chg == 0) area_cpy(&b->ori, &obj->cords);
+
+    if(b->inv == 0) {
+        if(resize != false) lv_obj_inv(obj);
+        else lv_obj_inv_moved(obj);
+        b->inv = 1;
+    }
+
+    if(resize != false) b->resized = 1;
+
+    return true;
+}
+
+/**
+ * Called after the coordinates of an object are changed.
+ * In a batch save the signals of the object and its parent to send them in 'lv_obj_batch_end'.
+ * @param obj pointer to an object
+ * @return true: the change is batched; false: no batch, handle the change normally
+ */
+static bool lv_obj_batch_chg(lv_obj_t * obj)
+{
+    if(batch_depth == 0) return false;
+
+    lv_obj_batch_t * b = lv_obj_batch_find(obj);
+    b->cords_chg = 1;
+
+    /*The parent gets one signal. (The protected parents would ignore it anyway)*/
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par != NULL && lv_obj_is_protected(par, LV_PROTECT_CHILD_CHG) == false) {
+        b = lv_obj_batch_find(par);
+        if(b->child_chg == 0) b->child = obj;
+        else if(b->child != obj) b->child = NULL;
+        b->child_chg = 1;
+    }
+
+    return true;
+}
+
+/**
+ * Remove a deleted object from the batch
+ * @param obj pointer to an object which is being deleted
+ */
+static void lv_obj_batch_rem(lv_obj_t * obj)
+{
+    if(ll_get_head(&batch_ll) == NULL) return;
+
+    lv_obj_batch_t * b;
+    LL_READ(batch_ll, b) {
+        if(b->obj == obj) b->obj = NULL;
+        if(b->child == obj) b->child = NULL;
+    }
+}
+
+/**
+ * Invalidate the area of an object which is moved.
+ * The object's own layer remains valid because the content doesn't change.
+ * @param obj pointer to an object
+ */
+static void lv_obj_inv_moved(lv_obj_t * obj)
+{
+#if LV_OBJ_LAYER != 0
+    uint8_t layer_valid = obj->layer_valid;
+    lv_obj_inv(obj);
+    obj->layer_valid = layer_valid;
+#else
+    lv_obj_inv(obj);
+#endif
+}
+
+#if LV_OBJ_LAYER != 0
+/**
+ * Mark the layers of an object and its parents as invalid (they have to be rendered again)
+ * @param obj pointer to an object
+ */
+static void lv_obj_inv_layer(lv_obj_t * obj)
+{
+    while(obj != NULL) {
+        obj->layer_valid = 0;
+        obj = lv_obj_get_parent(obj);
+    }
+}
+#endif
+
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Get the area whose drawn pixels can be copied when an object is moved.
+ * It is the visible part of the object if it is opaque there
+ * and no other object (younger siblings of the object or its parents) is on it.
+ * @param obj pointer to an object
+ * @param area_p store the area here
+ * @return true: the pixels can be copied; false: the object has to be redrawn
+ */
+static bool lv_obj_get_copy_area(lv_obj_t * obj, area_t * area_p)
+{
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL || obj->hidden != 0) return false;
+    if(lv_obj_get_scr(obj) != lv_scr_act()) return false;
+
+    /*Truncate the screen to the parents*/
+    area_t par_area;
+    area_set(&par_area, 0, 0, LV_HOR_RES - 1, LV_VER_RES - 1);
+    while(par != NULL) {
+        if(par->hidden != 0) return false;
+#if LV_OBJ_LAYER != 0
+        /*The layer of the parent would be drawn with the old content*/
+        if(par->layer_en != 0) return false;
+#endif
+        if(area_union(&par_area, &par_area, &par->cords) == false) return false;
+        par = lv_obj_get_parent(par);
+    }
+
+    /*Nothing can be drawn out of the object on the visible area (e.g. shadow)*/
+    area_t ext_area;
+    area_cpy(&ext_area, &obj->cords);
+    ext_area.x1 -= obj->ext_size;
+    ext_area.y1 -= obj->ext_size;
+    ext_area.x2 += obj->ext_size;
+    ext_area.y2 += obj->ext_size;
+    if(area_union(area_p, &obj->cords, &par_area) == false) return false;
+    area_union(&ext_area, &ext_area, &par_area);
+    if(memcmp(&ext_area, area_p, sizeof(area_t)) != 0) return false;
+
+    /*The object has to be opaque on the whole area*/
+    lv_style_t * style = lv_obj_get_style(obj);
+    if(style->opa != OPA_COVER) return false;
+    if(obj->design_f(obj, area_p, LV_DESIGN_COVER_CHK) == false) return false;
+
+    /*The younger siblings of the object and its parents are drawn later (on the top)*/
+    lv_obj_t * border_p = obj;
+    lv_obj_t * i;
+    area_t i_area;
+    par = lv_obj_get_parent(obj);
+    while(par != NULL) {
+        i = ll_get_prev(&par->child_ll, border_p);
+        while(i != NULL) {
+            if(i->hidden == 0) {
+                area_cpy(&i_area, &i->cords);
+                i_area.x1 -= i->ext_size;
+                i_area.y1 -= i->ext_size;
+                i_area.x2 += i->ext_size;
+                i_area.y2 += i->ext_size;
+                if(area_is_on(&i_area, area_p) != false) return false;
+            }
+            i = ll_get_prev(&par->child_ll, i);
+        }
+        border_p = par;
+        par = lv_obj_get_parent(par);
+    }
+
+    return true;
+}
+#endif
@@ -39,6 +39,30 @@ extern "C" {
 #error "LV: If LV_VDB_SIZE == 0 the antialaissing must be disabled"
 #endif
 
+#if defined(LV_EDGE_AA) && LV_EDGE_AA != 0 && LV_ANTIALIAS != 0
+#error "LV: LV_EDGE_AA can be used only if LV_ANTIALIAS is disabled"
+#endif
+
+#ifndef LV_OBJ_LAYER
+#define LV_OBJ_LAYER    0
+#endif
+
+#ifndef LV_OBJ_MOVE_COPY
+#define LV_OBJ_MOVE_COPY    0
+#endif
+
+#ifndef LV_OBJ_STYLE_RES
+#define LV_OBJ_STYLE_RES    0
+#endif
+
+#ifndef LV_OBJ_STYLE_INDEX
+#define LV_OBJ_STYLE_INDEX  0
+#endif
+
+#if LV_VDB_SIZE == 0 && LV_OBJ_LAYER != 0
+#error "LV: LV_OBJ_LAYER requires a Virtual Display Buffer (LV_VDB_SIZE > 0)"
+#endif
+
 #if LV_VDB_SIZE != 0 && LV_VDB_SIZE < LV_HOR_RES && LV_ANTIALIAS == 0
 #error "LV: Small Virtual Display Buffer (lv_conf.h: LV_VDB_SIZE >= LV_HOR_RES)"
 #endif
@@ -101,6 +125,13 @@ typedef struct __LV_OBJ_T
     
     void * ext;                 /*Object type specific extended data*/
     lv_style_t * style_p;       /*Pointer to the object's style*/
+#if LV_OBJ_STYLE_RES != 0
+    lv_style_t * style_res;     /*The inherited style if 'style_p' is NULL (NULL: not resolved yet. Handled by the library)*/
+#endif
+#if LV_OBJ_STYLE_INDEX != 0
+    struct __LV_OBJ_T * style_prev; /*Previous object in the list of the same style hash (Handled by the library)*/
+    struct __LV_OBJ_T * style_next; /*Next object in the list of the same style hash (Handled by the library)*/
+#endif
 
 #if LV_OBJ_FREE_P != 0
     void * free_p;              /*Application specific pointer (set it freely)*/
@@ -113,7 +144,15 @@ typedef struct __LV_OBJ_T
     uint8_t drag_parent  :1;    /*1: Parent will be dragged instead*/
     uint8_t hidden       :1;    /*1: Object is hidden*/
     uint8_t top_en       :1;    /*1: If the object or its children is clicked it goes to the foreground*/
+#if LV_OBJ_MOVE_COPY != 0
+    uint8_t move_copy    :1;    /*1: On move copy the drawn pixels on the display instead of redrawing them*/
+#else
     uint8_t reserved     :1;
+#endif
+#if LV_OBJ_LAYER != 0
+    uint8_t layer_en     :1;    /*1: Render the object and its children into 'layer_buf' and draw them from there*/
+    uint8_t layer_valid  :1;    /*1: 'layer_buf' is up to date (Handled by the library)*/
+#endif
 
     uint8_t protect;            /*Automatically happening actions can be prevented. 'OR'ed values from lv_obj_prot_t*/
 
@@ -122,6 +161,11 @@ typedef struct __LV_OBJ_T
 #if LV_OBJ_FREE_NUM != 0
     uint8_t free_num; 		    /*Application specific identifier (set it freely)*/
 #endif
+
+#if LV_OBJ_LAYER != 0
+    color_t * layer_buf;        /*The rendered object with its children (Handled by the library)*/
+    uint32_t layer_px;          /*Size of 'layer_buf' in pixels*/
+#endif
 }lv_obj_t;
 
 /*Protect some attributes (max. 8 bit)*/
@@ -216,6 +260,28 @@ bool lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param);
  */
 void lv_obj_inv(lv_obj_t * obj);
 
+/**
+ * Mark an area of an object as invalid (e.g. a changed part of it) therefore it will be redrawn by 'lv_refr_task'.
+ * Use it instead of 'lv_inv_area' because the layers of the object and its parents are invalidated too.
+ * @param obj pointer to an object
+ * @param area_p the area to redraw (absolute coordinates)
+ */
+void lv_obj_inv_area(lv_obj_t * obj, const area_t * area_p);
+
+/**
+ * Start a batch of coordinate changes. Until 'lv_obj_batch_end' the position and size setters
+ * only change the coordinates. The LV_SIGNAL_CORD_CHG and LV_SIGNAL_CHILD_CHG signals are sent
+ * (once per object) and the new areas are invalidated in 'lv_obj_batch_end'.
+ * The batches can be nested.
+ */
+void lv_obj_batch_start(void);
+
+/**
+ * Finish a batch of coordinate changes started with 'lv_obj_batch_start'.
+ * Send the saved signals (e.g. to refresh the layouts) and invalidate the changed objects.
+ */
+void lv_obj_batch_end(void);
+
 /**
  * Load a new screen
  * @param scr pointer to a screen
@@ -292,6 +358,13 @@ void lv_obj_set_size(lv_obj_t * obj, cord_t w, cord_t h);
  */
 void lv_obj_set_size_us(lv_obj_t * obj, cord_t w, cord_t h);
 
+/**
+ * Set the absolute coordinates of an object without moving its children (e.g. to fit to the children)
+ * @param obj pointer to an object
+ * @param cords_p pointer to the new coordinates
+ */
+void lv_obj_set_cords(lv_obj_t * obj, const area_t * cords_p);
+
 /**
  * Set the width of an object
  * @param obj pointer to an object
@@ -389,6 +462,31 @@ void lv_obj_set_click(lv_obj_t * obj, bool en);
  */
 void lv_obj_set_top(lv_obj_t * obj, bool en);
 
+#if LV_OBJ_LAYER != 0
+/**
+ * Cache the rendered object and its children in a layer. Until the object or
+ * a child is invalidated (e.g. a style or text change) the layer is simply copied
+ * to the screen instead of drawing the objects again, even if the object is moved.
+ * The layer needs width * height pixels memory. It is used only if the object covers its area
+ * (opaque, not rounded body) else the object is drawn directly. The shadow is always drawn directly.
+ * @param obj pointer to an object
+ * @param en true: enable the layer, false: disable it and free its memory
+ */
+void lv_obj_set_layer(lv_obj_t * obj, bool en);
+#endif
+
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Enable to copy the already drawn pixels on the display when the object is moved
+ * (see 'lv_refr_set_copy_cb') and redraw only the newly exposed parts.
+ * It is used only if the object is opaque and covers the whole visible area of its parents
+ * and no other object is on this area (e.g. the scrollable part of a page).
+ * @param obj pointer to an object
+ * @param en true: enable the copy on move
+ */
+void lv_obj_set_move_copy(lv_obj_t * obj, bool en);
+#endif
+
 /**
  * Enable the dragging of an object
  * @param obj pointer to an object
@@ -589,6 +687,24 @@ bool lv_obj_get_click(lv_obj_t * obj);
  */
 bool lv_obj_get_top(lv_obj_t * obj);
 
+#if LV_OBJ_LAYER != 0
+/**
+ * Get whether the object is rendered via a layer
+ * @param obj pointer to an object
+ * @return true: the layer is enabled
+ */
+bool lv_obj_get_layer(lv_obj_t * obj);
+#endif
+
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Get whether the drawn pixels are copied when the object is moved
+ * @param obj pointer to an object
+ * @return true: the copy on move is enabled
+ */
+bool lv_obj_get_move_copy(lv_obj_t * obj);
+#endif
+
 /**
  * Get the drag enable attribute of an object
  * @param obj pointer to an object
@@ -0,0 +1,212 @@
+/**
+ * @file lv_prof.c
+ * 
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_prof.h"
+#if LV_PROF != 0
+
+#include <stdio.h>
+#include <string.h>
+#include "hal/systick/systick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/* The draw primitives are measured on all the rendering threads (LV_REFR_THREAD_NUM > 1)
+ * so their counters are increased atomically.
+ * Redefine it in lv_conf.h if the compiler has no '__atomic' built-ins*/
+#ifndef LV_PROF_ATOMIC_ADD
+#define LV_PROF_ATOMIC_ADD(var, value)  __atomic_fetch_add(&(var), (value), __ATOMIC_RELAXED)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_prof_frame_t frames[LV_PROF_FRAME_NUM];
+static uint8_t frame_wr;            /*Index of the frame being recorded*/
+static uint32_t frame_cnt;          /*Number of saved frames*/
+static uint32_t frame_start;
+static bool frame_act;
+static uint32_t (*time_f)(void) = systick_get;
+static const char * prim_txt[LV_PROF_PRIM_NUM] = {"rect", "shadow", "label", "img", "line", "flush"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Set the time source of the profiler. 'systick_get' (1 ms) is used by default
+ * which is too coarse to measure the primitives. Use a faster counter if available.
+ * @param time_cb pointer to a function which returns the current time (e.g. in us)
+ */
+void lv_prof_set_time_cb(uint32_t (*time_cb)(void))
+{
+    if(time_cb == NULL) time_cb = systick_get;
+    time_f = time_cb;
+}
+
+/**
+ * Start a new frame. Called by the refresh task.
+ */
+void lv_prof_frame_start(void)
+{
+    memset(&frames[frame_wr], 0, sizeof(lv_prof_frame_t));
+    frame_act = true;
+    frame_start = time_f();
+}
+
+/**
+ * Close the current frame and save it among the recent frames. Called by the refresh task.
+ * @param px_num number of refreshed pixels
+ */
+void lv_prof_frame_end(uint32_t px_num)
+{
+    if(frame_act == false) return;
+
+    lv_prof_frame_t * frame = &frames[frame_wr];
+    frame->time = time_f() - frame_start;
+    frame->px_num = px_num;
+    frame->id = frame_cnt;
+
+    frame_act = false;
+    frame_cnt++;
+    frame_wr++;
+    if(frame_wr >= LV_PROF_FRAME_NUM) frame_wr = 0;
+}
+
+/**
+ * Count a VDB part in the current frame. Called by the refresh task.
+ */
+void lv_prof_band(void)
+{
+    if(frame_act == false) return;
+
+    frames[frame_wr].band_num++;
+}
+
+/**
+ * Get a time stamp to start a measurement
+ * @return the current time from the time source
+ */
+uint32_t lv_prof_start(void)
+{
+    return time_f();
+}
+
+/**
+ * Close the measurement of a draw primitive
+ * @param prim the measured primitive from 'lv_prof_prim_t'
+ * @param start time stamp from 'lv_prof_start()'
+ */
+void lv_prof_prim_end(lv_prof_prim_t prim, uint32_t start)
+{
+    if(frame_act == false || prim >= LV_PROF_PRIM_NUM) return;
+
+    LV_PROF_ATOMIC_ADD(frames[frame_wr].prim_time[prim], time_f() - start);
+    LV_PROF_ATOMIC_ADD(frames[frame_wr].prim_cnt[prim], 1);
+}
+
+/**
+ * Close the measurement of an object's design function
+ * @param obj pointer to the drawn object
+ * @param start time stamp from 'lv_prof_start()'
+ */
+void lv_prof_obj_end(lv_obj_t * obj, uint32_t start)
+{
+    if(frame_act == false) return;
+
+    uint32_t t = time_f() - start;
+    lv_prof_obj_t * objs = frames[frame_wr].obj;
+    lv_prof_obj_t * min_p = &objs[0];
+    uint8_t i;
+
+    /*Add to the object if it is already saved (drawn in an other area or VDB part)*/
+    for(i = 0; i < LV_PROF_OBJ_NUM; i++) {
+        if(objs[i].obj == obj) {
+            objs[i].time += t;
+            objs[i].cnt++;
+            return;
+        }
+        if(objs[i].time < min_p->time || objs[i].obj == NULL) min_p = &objs[i];
+        if(objs[i].obj == NULL) break;
+    }
+
+    /*Keep only the slowest objects: replace the fastest if this one is slower*/
+    if(min_p->obj == NULL || min_p->time < t) {
+        min_p->obj = obj;
+        min_p->design_f = obj->design_f;
+        min_p->time = t;
+        min_p->cnt = 1;
+    }
+}
+
+/**
+ * Get a recent frame
+ * @param age 0: the last frame, 1: the one before it ... (< LV_PROF_FRAME_NUM)
+ * @return pointer to the frame or NULL if there is no such frame yet
+ */
+const lv_prof_frame_t * lv_prof_get_frame(uint8_t age)
+{
+    if(age >= LV_PROF_FRAME_NUM || age >= frame_cnt) return NULL;
+
+    int16_t i = (int16_t)frame_wr - 1 - age;
+    if(i < 0) i += LV_PROF_FRAME_NUM;
+
+    return &frames[i];
+}
+
+/**
+ * Print the recent frames (oldest first) line by line
+ * @param print_cb pointer to a function which prints a '\0' terminated line
+ */
+void lv_prof_dump(void (*print_cb)(const char * txt))
+{
+    char buf[80];
+    int16_t age;
+    uint8_t i;
+
+    for(age = LV_PROF_FRAME_NUM - 1; age >= 0; age--) {
+        const lv_prof_frame_t * frame = lv_prof_get_frame(age);
+        if(frame == NULL) continue;
+
+        sprintf(buf, "Frame %lu: %lu (px: %lu, parts: %u)\n", (unsigned long)frame->id,
+                (unsigned long)frame->time, (unsigned long)frame->px_num, frame->band_num);
+        print_cb(buf);
+
+        for(i = 0; i < LV_PROF_PRIM_NUM; i++) {
+            if(frame->prim_cnt[i] == 0) continue;
+            sprintf(buf, "  %s: %lu (%lu calls)\n", prim_txt[i],
+                    (unsigned long)frame->prim_time[i], (unsigned long)frame->prim_cnt[i]);
+            print_cb(buf);
+        }
+
+        for(i = 0; i < LV_PROF_OBJ_NUM; i++) {
+            if(frame->obj[i].obj == NULL) continue;
+            sprintf(buf, "  obj %p (design %p): %lu (%u calls)\n", (void *)frame->obj[i].obj,
+                    (void *)frame->obj[i].design_f, (unsigned long)frame->obj[i].time, frame->obj[i].cnt);
+            print_cb(buf);
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_PROF != 0*/
@@ -0,0 +1,144 @@
+/**
+ * @file lv_prof.h
+ * Render profiler: measure the design functions, the draw primitives and the flushing
+ */
+
+#ifndef LV_PROF_H
+#define LV_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_PROF
+#define LV_PROF     0
+#endif
+
+#if LV_PROF != 0
+
+#include <stdint.h>
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_PROF_FRAME_NUM
+#define LV_PROF_FRAME_NUM   8
+#endif
+
+#ifndef LV_PROF_OBJ_NUM
+#define LV_PROF_OBJ_NUM     8
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Measured draw primitives. The times are inclusive (e.g. 'SHADOW' is part of 'RECT').
+ * With LV_REFR_THREAD_NUM > 1 the times of the threads are added up*/
+typedef enum
+{
+    LV_PROF_PRIM_RECT = 0,
+    LV_PROF_PRIM_SHADOW,
+    LV_PROF_PRIM_LABEL,
+    LV_PROF_PRIM_IMG,
+    LV_PROF_PRIM_LINE,
+    LV_PROF_PRIM_FLUSH,
+    LV_PROF_PRIM_NUM,
+}lv_prof_prim_t;
+
+typedef struct
+{
+    lv_obj_t * obj;             /*The object (might be deleted since the frame)*/
+    lv_design_f_t design_f;     /*Design function of the object to identify its type*/
+    uint32_t time;              /*Time spent in the design function (without the children)*/
+    uint16_t cnt;               /*Number of design function calls*/
+}lv_prof_obj_t;
+
+typedef struct
+{
+    uint32_t id;                            /*Number of the frame since start up*/
+    uint32_t time;                          /*Time of the whole refresh*/
+    uint32_t px_num;                        /*Number of refreshed pixels*/
+    uint16_t band_num;                      /*Number of VDB parts rendered and flushed*/
+    uint32_t prim_time[LV_PROF_PRIM_NUM];   /*Time of the draw primitives*/
+    uint32_t prim_cnt[LV_PROF_PRIM_NUM];    /*Number of draw primitive calls*/
+    lv_prof_obj_t obj[LV_PROF_OBJ_NUM];     /*The slowest objects in the frame*/
+}lv_prof_frame_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the time source of the profiler. 'systick_get' (1 ms) is used by default
+ * which is too coarse to measure the primitives. Use a faster counter if available.
+ * @param time_cb pointer to a function which returns the current time (e.g. in us)
+ */
+void lv_prof_set_time_cb(uint32_t (*time_cb)(void));
+
+/**
+ * Start a new frame. Called by the refresh task.
+ */
+void lv_prof_frame_start(void);
+
+/**
+ * Close the current frame and save it among the recent frames. Called by the refresh task.
+ * @param px_num number of refreshed pixels
+ */
+void lv_prof_frame_end(uint32_t px_num);
+
+/**
+ * Count a VDB part in the current frame. Called by the refresh task.
+ */
+void lv_prof_band(void);
+
+/**
+ * Get a time stamp to start a measurement
+ * @return the current time from the time source
+ */
+uint32_t lv_prof_start(void);
+
+/**
+ * Close the measurement of a draw primitive
+ * @param prim the measured primitive from 'lv_prof_prim_t'
+ * @param start time stamp from 'lv_prof_start()'
+ */
+void lv_prof_prim_end(lv_prof_prim_t prim, uint32_t start);
+
+/**
+ * Close the measurement of an object's design function
+ * @param obj pointer to the drawn object
+ * @param start time stamp from 'lv_prof_start()'
+ */
+void lv_prof_obj_end(lv_obj_t * obj, uint32_t start);
+
+/**
+ * Get a recent frame
+ * @param age 0: the last frame, 1: the one before it ... (< LV_PROF_FRAME_NUM)
+ * @return pointer to the frame or NULL if there is no such frame yet
+ */
+const lv_prof_frame_t * lv_prof_get_frame(uint8_t age);
+
+/**
+ * Print the recent frames (oldest first) line by line
+ * @param print_cb pointer to a function which prints a '\0' terminated line
+ */
+void lv_prof_dump(void (*print_cb)(const char * txt));
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_PROF != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PROF_H*/
@@ -7,16 +7,26 @@
  *      INCLUDES
  *********************/
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include "lv_conf.h"
 #include "misc/os/ptask.h"
 #include "misc/mem/fifo.h"
 #include "lv_refr.h"
 #include "lv_vdb.h"
+#include "lv_dispi.h"
+#include "lv_prof.h"
+#include "lv_tpool.h"
+#include "../lv_draw/lv_draw_vbasic.h"
+#include "../lv_draw/lv_dlist.h"
 #include "hal/systick/systick.h"
 
 /*********************
  *      DEFINES
  *********************/
+#ifndef LV_REFR_OCCL_NUM
+#define LV_REFR_OCCL_NUM    0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -27,12 +37,31 @@ typedef struct
     uint8_t joined;
 }lv_join_t;
 
+#if LV_REFR_OCCL_NUM != 0
+typedef struct
+{
+    area_t area;        /*Area on the parent's mask which is fully covered by 'obj'*/
+    lv_obj_t * obj;
+}lv_occl_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_task(void * param);
+#if LV_REFR_FRAME_SYNC != 0
+static void lv_refr_frame_task(void * param);
+#endif
+static void lv_refr_inv_rem_covered(const area_t * area_p);
+static void lv_refr_inv_merge(const area_t * area_p);
+static void lv_refr_sort_area(void);
 static void lv_refr_join_area(void);
+static void lv_refr_trim_area(lv_join_t * a1_p, lv_join_t * a2_p);
 static void lv_refr_areas(void);
+#if LV_OBJ_MOVE_COPY != 0
+static void lv_refr_copy_exec(void);
+static void lv_refr_inv_diff(const area_t * area_p, const area_t * keep_p);
+#endif
 #if LV_VDB_SIZE == 0
 static void lv_refr_area_no_vdb(const area_t * area_p);
 #else
@@ -42,6 +71,14 @@ static void lv_refr_area_part_vdb(const area_t * area_p);
 static lv_obj_t * lv_refr_get_top_obj(const area_t * area_p, lv_obj_t * obj);
 static void lv_refr_make(lv_obj_t * top_p, const area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p);
+#if LV_OBJ_LAYER != 0
+static void lv_refr_layer(lv_obj_t * obj, const area_t * mask_p);
+static void lv_refr_layer_ext(lv_obj_t * obj, const area_t * mask_p);
+#endif
+#if LV_REFR_OCCL_NUM != 0
+static uint8_t lv_refr_occl_collect(lv_obj_t * obj, const area_t * mask_p, lv_occl_t * occl);
+static bool lv_refr_occl_clip(area_t * mask_p, const lv_occl_t * occl, uint8_t occl_num);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -50,6 +87,23 @@ static lv_join_t inv_buf[LV_INV_FIFO_SIZE];
 static uint16_t inv_buf_p;
 static void (*monitor_cb)(uint32_t, uint32_t);
 static uint32_t px_num;
+#if LV_OBJ_MOVE_COPY != 0
+static bool (*copy_cb)(const area_t *, cord_t, cord_t);
+static area_t copy_area;        /*The area whose pixels has to be moved in the next refresh*/
+static point_t copy_diff;       /*The sum of the movements since the last refresh*/
+static bool copy_pend;
+#endif
+#if LV_OBJ_LAYER != 0
+static lv_obj_t * layer_obj;    /*The object which is being rendered into its layer*/
+#endif
+#if LV_REFR_FRAME_SYNC != 0
+static ptask_t * frame_task_p;
+static uint32_t frame_last;     /*Start time of the last frame*/
+static lv_refr_frame_stat_t frame_stat;
+#endif
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+static bool dlist_ready;        /*The drawings of the actual area are recorded in the display list*/
+#endif
 
 /**********************
  *      MACROS
@@ -68,13 +122,27 @@ void lv_refr_init(void)
     memset(inv_buf, 0, sizeof(inv_buf));
 
     ptask_t* task;
+#if LV_REFR_FRAME_SYNC != 0
+    /*Process the input and refresh in the same task*/
+    task = ptask_create(lv_refr_frame_task, LV_REFR_PERIOD, PTASK_PRIO_MID, NULL);
+    dm_assert(task);
+    frame_task_p = task;
+    frame_last = systick_get();
+    memset(&frame_stat, 0, sizeof(frame_stat));
+#else
     task = ptask_create(lv_refr_task, LV_REFR_PERIOD, PTASK_PRIO_MID, NULL);
     dm_assert(task);
+#endif
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+    lv_tpool_init();
+#endif
     
 }
 
 /**
- * Invalidate an area
+ * Invalidate an area. The layers of the objects are not invalidated,
+ * use 'lv_obj_inv_area' to redraw a part of an object.
  * @param area_p pointer to area which should be invalidated
  */
 void lv_inv_area(const area_t * area_p)
@@ -82,6 +150,9 @@ void lv_inv_area(const area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         inv_buf_p = 0;
+#if LV_OBJ_MOVE_COPY != 0
+        copy_pend = false;
+#endif
         return;
     }
     
@@ -113,15 +184,16 @@ void lv_inv_area(const area_t * area_p)
     	    if(area_is_in(&com_area, &inv_buf[i].area) != false) return;
     	}
 
+    	/*Remove the saved areas which are in the new area*/
+    	lv_refr_inv_rem_covered(&com_area);
 
         /*Save the area*/
     	if(inv_buf_p < LV_INV_FIFO_SIZE) {
             area_cpy(&inv_buf[inv_buf_p].area,&com_area);
-    	} else {/*If no place for the area add the screen*/
-    	    inv_buf_p = 0;
-            area_cpy(&inv_buf[inv_buf_p].area,&scr_area);
+            inv_buf_p ++;
+    	} else {/*If no place for the area join it to the most suitable saved area*/
+    	    lv_refr_inv_merge(&com_area);
         }
-    	inv_buf_p ++;
     }
 }
 
@@ -137,6 +209,123 @@ void lv_refr_set_monitor_cb(void (*cb)(uint32_t, uint32_t))
     monitor_cb = cb;
 }
 
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Set a function to copy an area of the display to an other position.
+ * It is used to move the drawn pixels instead of redrawing them (see 'lv_obj_set_move_copy').
+ * @param cb pointer to a callback function (bool my_copy_cb(const area_t * area_p, cord_t dx, cord_t dy))
+ *           area_p: the area to copy in display coordinates
+ *           dx, dy: copy 'area_p' to here relative to its original position. The areas can overlap.
+ *           return: true: the pixels are copied; false: the copy is not possible (the area will be redrawn)
+ */
+void lv_refr_set_copy_cb(bool (*cb)(const area_t *, cord_t, cord_t))
+{
+    copy_cb = cb;
+}
+
+/**
+ * Move the drawn pixels of an area in the next refresh instead of redrawing them.
+ * The newly exposed parts of the area are invalidated.
+ * Only one area can be moved in a refresh period (but the same area more times)
+ * @param area_p pointer to the area which content is moved
+ * @param dx horizontal movement
+ * @param dy vertical movement
+ * @return true: the move is saved; false: the move is not possible so invalidate the area instead
+ */
+bool lv_refr_move_area(const area_t * area_p, cord_t dx, cord_t dy)
+{
+    if(copy_cb == NULL) return false;
+
+    if(copy_pend != false) {
+        if(memcmp(&copy_area, area_p, sizeof(area_t)) != 0) return false;
+    } else {
+        area_cpy(&copy_area, area_p);
+        copy_diff.x = 0;
+        copy_diff.y = 0;
+        copy_pend = true;
+    }
+
+    copy_diff.x += dx;
+    copy_diff.y += dy;
+
+    /*The part of the area which remains in the area after the move*/
+    area_t keep;
+    area_t src;
+    bool keep_ok;
+    area_cpy(&keep, area_p);
+    keep.x1 += dx;
+    keep.y1 += dy;
+    keep.x2 += dx;
+    keep.y2 += dy;
+    keep_ok = area_union(&keep, &keep, area_p);
+
+    if(keep_ok == false) {
+        lv_inv_area(area_p);
+        return true;
+    }
+
+    /* The not redrawn pixels of the invalid areas are moved too
+     * so invalidate the moved invalid areas as well*/
+    area_cpy(&src, &keep);
+    src.x1 -= dx;
+    src.y1 -= dy;
+    src.x2 -= dx;
+    src.y2 -= dy;
+
+    area_t moved_a[LV_INV_FIFO_SIZE];
+    uint16_t moved_num = 0;
+    uint16_t i;
+    for(i = 0; i < inv_buf_p; i++) {
+        if(area_union(&moved_a[moved_num], &inv_buf[i].area, &src) != false) {
+            moved_a[moved_num].x1 += dx;
+            moved_a[moved_num].y1 += dy;
+            moved_a[moved_num].x2 += dx;
+            moved_a[moved_num].y2 += dy;
+            moved_num ++;
+        }
+    }
+
+    for(i = 0; i < moved_num; i++) {
+        lv_inv_area(&moved_a[i]);
+    }
+
+    /*Invalidate the newly exposed parts*/
+    lv_refr_inv_diff(area_p, &keep);
+
+    return true;
+}
+#endif
+
+/**
+ * Redraw the invalidated areas now instead of waiting for the periodic refresh task
+ * (e.g. to refresh during a long blocking process or to drive the drawing from a test or benchmark)
+ */
+void lv_refr_now(void)
+{
+    lv_refr_task(NULL);
+}
+
+#if LV_REFR_FRAME_SYNC != 0
+/**
+ * Start the next frame at the next 'ptask_handler' call instead of waiting for LV_REFR_PERIOD.
+ * Call it on the vertical sync. or tearing effect signal of the display
+ * (from the context of 'ptask_handler', e.g. after the interrupt set a flag)
+ */
+void lv_refr_vsync(void)
+{
+    ptask_ready(frame_task_p);
+}
+
+/**
+ * Get the statistics of the frames
+ * @param stat pointer to a 'lv_refr_frame_stat_t' variable to store the result
+ */
+void lv_refr_get_frame_stat(lv_refr_frame_stat_t * stat)
+{
+    memcpy(stat, &frame_stat, sizeof(lv_refr_frame_stat_t));
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -150,6 +339,15 @@ static void lv_refr_task(void * param)
 
     uint32_t start = systick_get();
 
+#if LV_PROF != 0
+    lv_prof_frame_start();
+#endif
+
+#if LV_OBJ_MOVE_COPY != 0
+    /*Move the pixels first and draw the invalid areas onto them*/
+    lv_refr_copy_exec();
+#endif
+
     lv_refr_join_area();
     
     lv_refr_areas();
@@ -162,6 +360,9 @@ static void lv_refr_task(void * param)
     /* In the callback lv_obj_inv can occur
      * therefore be sure the inv_buf is cleared prior to it*/
     if(refr_done != false) {
+#if LV_PROF != 0
+        lv_prof_frame_end(px_num);
+#endif
         if(monitor_cb != NULL) {
             monitor_cb(systick_elaps(start), px_num);
         }
@@ -169,6 +370,197 @@ static void lv_refr_task(void * param)
 }
 
 
+#if LV_REFR_FRAME_SYNC != 0
+/**
+ * Called periodically or on vertical sync. to process a frame:
+ * first the display inputs, then the refresh of the invalid areas (if any)
+ * @param param unused
+ */
+static void lv_refr_frame_task(void * param)
+{
+    uint32_t start = systick_get();
+    uint32_t elaps = start - frame_last;
+    frame_last = start;
+
+    /*Count the periods when the task couldn't run (e.g. a too long frame or other tasks)*/
+    if(elaps >= 2 * LV_REFR_PERIOD) frame_stat.drop_num += elaps / LV_REFR_PERIOD - 1;
+
+#if LV_DISPI_READ_PERIOD != 0
+    /*Process the input first to draw its result in this frame ('lv_init' starts it only in this case)*/
+    lv_dispi_proc();
+#endif
+
+    /*Skip the frame if nothing has changed*/
+    bool dirty = inv_buf_p != 0 ? true : false;
+#if LV_OBJ_MOVE_COPY != 0
+    if(copy_pend != false) dirty = true;
+#endif
+    if(dirty == false) {
+        frame_stat.skip_num ++;
+        return;
+    }
+
+    lv_refr_task(NULL);
+
+    frame_stat.frame_num ++;
+    if(systick_elaps(start) > LV_REFR_PERIOD) frame_stat.late_num ++;
+}
+#endif
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Move the pixels of the area saved by 'lv_refr_move_area' with 'copy_cb'
+ */
+static void lv_refr_copy_exec(void)
+{
+    if(copy_pend == false) return;
+    copy_pend = false;
+
+    if(copy_diff.x == 0 && copy_diff.y == 0) return;
+
+    /*Nothing to do if the whole area is redrawn anyway*/
+    uint16_t i;
+    for(i = 0; i < inv_buf_p; i++) {
+        if(area_is_in(&copy_area, &inv_buf[i].area) != false) return;
+    }
+
+    /*The target of the copy: the moved area truncated to the original*/
+    area_t dest;
+    bool copy_ok;
+    area_cpy(&dest, &copy_area);
+    dest.x1 += copy_diff.x;
+    dest.y1 += copy_diff.y;
+    dest.x2 += copy_diff.x;
+    dest.y2 += copy_diff.y;
+    copy_ok = area_union(&dest, &dest, &copy_area);
+
+#if LV_DOWNSCALE == 2
+    /*Only whole display pixels can be copied*/
+    if((copy_diff.x & 0x1) != 0 || (copy_diff.y & 0x1) != 0) copy_ok = false;
+    dest.x1 = (dest.x1 + 1) & (~0x1);
+    dest.y1 = (dest.y1 + 1) & (~0x1);
+    dest.x2 = ((dest.x2 + 1) & (~0x1)) - 1;
+    dest.y2 = ((dest.y2 + 1) & (~0x1)) - 1;
+    if(dest.x1 > dest.x2 || dest.y1 > dest.y2) copy_ok = false;
+#endif
+
+    if(copy_ok != false) {
+        area_t src;
+        src.x1 = (dest.x1 - copy_diff.x) / LV_DOWNSCALE;
+        src.y1 = (dest.y1 - copy_diff.y) / LV_DOWNSCALE;
+        src.x2 = (dest.x2 - copy_diff.x) / LV_DOWNSCALE;
+        src.y2 = (dest.y2 - copy_diff.y) / LV_DOWNSCALE;
+
+#if LV_VDB_SIZE != 0
+        /*The display can't be changed while a VDB is flushed*/
+        lv_vdb_wait_flush();
+#endif
+        copy_ok = copy_cb(&src, copy_diff.x / LV_DOWNSCALE, copy_diff.y / LV_DOWNSCALE);
+    }
+
+    if(copy_ok != false) lv_refr_inv_diff(&copy_area, &dest);
+    else lv_inv_area(&copy_area);
+}
+
+/**
+ * Invalidate the parts of an area which are out of an other area
+ * @param area_p pointer to an area to invalidate
+ * @param keep_p pointer to an area in 'area_p' which should not be invalidated
+ */
+static void lv_refr_inv_diff(const area_t * area_p, const area_t * keep_p)
+{
+    area_t inv;
+
+    /*Top and bottom*/
+    if(keep_p->y1 > area_p->y1) {
+        area_set(&inv, area_p->x1, area_p->y1, area_p->x2, keep_p->y1 - 1);
+        lv_inv_area(&inv);
+    }
+    if(keep_p->y2 < area_p->y2) {
+        area_set(&inv, area_p->x1, keep_p->y2 + 1, area_p->x2, area_p->y2);
+        lv_inv_area(&inv);
+    }
+
+    /*Left and right between the top and bottom*/
+    if(keep_p->x1 > area_p->x1) {
+        area_set(&inv, area_p->x1, keep_p->y1, keep_p->x1 - 1, keep_p->y2);
+        lv_inv_area(&inv);
+    }
+    if(keep_p->x2 < area_p->x2) {
+        area_set(&inv, keep_p->x2 + 1, keep_p->y1, area_p->x2, keep_p->y2);
+        lv_inv_area(&inv);
+    }
+}
+#endif
+
+/**
+ * Remove the saved invalid areas which are fully covered by a new area
+ * @param area_p pointer to the new area
+ */
+static void lv_refr_inv_rem_covered(const area_t * area_p)
+{
+    uint16_t i = 0;
+    while(i < inv_buf_p) {
+        if(area_is_in(&inv_buf[i].area, area_p) != false) {
+            /*Move the last area to the place of the removed one*/
+            inv_buf_p --;
+            memcpy(&inv_buf[i], &inv_buf[inv_buf_p], sizeof(lv_join_t));
+        } else {
+            i++;
+        }
+    }
+}
+
+/**
+ * Merge a new area into the saved area which grows the least by it.
+ * Used when the invalidate buffer is full.
+ * @param area_p pointer to the new area
+ */
+static void lv_refr_inv_merge(const area_t * area_p)
+{
+    uint16_t i;
+    uint16_t best_i = 0;
+    uint32_t best_grow = UINT32_MAX;
+    uint32_t grow;
+    area_t joined_area;
+
+    for(i = 0; i < inv_buf_p; i++) {
+        area_join(&joined_area, area_p, &inv_buf[i].area);
+        grow = area_get_size(&joined_area) - area_get_size(&inv_buf[i].area);
+        if(grow < best_grow) {
+            best_grow = grow;
+            best_i = i;
+        }
+    }
+
+    area_join(&joined_area, area_p, &inv_buf[best_i].area);
+
+    /* Remove the chosen area and save the joined one again.
+     * The joined area can cover other saved areas too */
+    inv_buf_p --;
+    memcpy(&inv_buf[best_i], &inv_buf[inv_buf_p], sizeof(lv_join_t));
+    lv_inv_area(&joined_area);
+}
+
+/**
+ * Sort the invalid areas by their top coordinate
+ */
+static void lv_refr_sort_area(void)
+{
+    /*Insertion sort: the number of areas is small and they are often nearly sorted*/
+    uint16_t i;
+    int32_t j;
+    lv_join_t tmp;
+    for(i = 1; i < inv_buf_p; i++) {
+        memcpy(&tmp, &inv_buf[i], sizeof(lv_join_t));
+        j = i - 1;
+        while(j >= 0 && inv_buf[j].area.y1 > tmp.area.y1) {
+            memcpy(&inv_buf[j + 1], &inv_buf[j], sizeof(lv_join_t));
+            j--;
+        }
+        memcpy(&inv_buf[j + 1], &tmp, sizeof(lv_join_t));
+    }
+}
+
 /**
  * Join the areas which has got common parts
  */
@@ -177,35 +569,81 @@ static void lv_refr_join_area(void)
     uint32_t join_from;
     uint32_t join_in;
     area_t joined_area;
+    bool joined_now;
+
+    /*With sorted areas only the next few areas has to be checked*/
+    lv_refr_sort_area();
+
     for(join_in = 0; join_in < inv_buf_p; join_in++) {
         if(inv_buf[join_in].joined != 0) continue;
         
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < inv_buf_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(inv_buf[join_from].joined != 0 || join_in == join_from) {
-                continue;
-            }
+        do {
+            joined_now = false;
 
-            /*Check if the areas are on each other*/
-            if(area_is_on(&inv_buf[join_in].area,
-                          &inv_buf[join_from].area) == false)
-            {
-                continue;
-            }
-            
-            area_join(&joined_area, &inv_buf[join_in].area,
-                                    &inv_buf[join_from].area);
+            /*Check the next areas to join them in 'join_in'*/
+            for(join_from = join_in + 1; join_from < inv_buf_p; join_from++) {
+                /*Handle only unjoined areas*/
+                if(inv_buf[join_from].joined != 0) continue;
+
+                /*The areas are sorted so the next ones are not on 'join_in' too*/
+                if(inv_buf[join_from].area.y1 > inv_buf[join_in].area.y2) break;
+
+                /*Check if the areas are on each other*/
+                if(area_is_on(&inv_buf[join_in].area,
+                              &inv_buf[join_from].area) == false)
+                {
+                    continue;
+                }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(area_get_size(&joined_area) < 
-             (area_get_size(&inv_buf[join_in].area) + area_get_size(&inv_buf[join_from].area))) {
-                area_cpy(&inv_buf[join_in].area, &joined_area);
+                area_join(&joined_area, &inv_buf[join_in].area,
+                                        &inv_buf[join_from].area);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                inv_buf[join_from].joined = 1;
+                /*Join two area only if the joined area size is smaller*/
+                if(area_get_size(&joined_area) <
+                 (area_get_size(&inv_buf[join_in].area) + area_get_size(&inv_buf[join_from].area))) {
+                    area_cpy(&inv_buf[join_in].area, &joined_area);
+
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    inv_buf[join_from].joined = 1;
+                    joined_now = true;
+                } else {
+                    /*Not worth to join them but do not refresh the common part twice*/
+                    lv_refr_trim_area(&inv_buf[join_in], &inv_buf[join_from]);
+                }
             }
-        }   
+        } while(joined_now != false);   /*'join_in' has grown so check the next areas again*/
+    }
+}
+
+/**
+ * Remove the common part of two overlapping areas from one of them
+ * if the result is still a rectangle.
+ * @param a1_p pointer to an area
+ * @param a2_p pointer to an area after 'a1_p' (a1_p->area.y1 <= a2_p->area.y1)
+ */
+static void lv_refr_trim_area(lv_join_t * a1_p, lv_join_t * a2_p)
+{
+    area_t * a1 = &a1_p->area;
+    area_t * a2 = &a2_p->area;
+
+    /*'a1' is wider: remove the common rows from the top of 'a2'*/
+    if(a1->x1 <= a2->x1 && a1->x2 >= a2->x2) {
+        if(a1->y2 >= a2->y2) a2_p->joined = 1;     /*Fully covered, no need to refresh*/
+        else a2->y1 = a1->y2 + 1;
+    }
+    /*'a2' is wider: remove the common rows from the bottom of 'a1'*/
+    else if(a2->x1 <= a1->x1 && a2->x2 >= a1->x2) {
+        if(a1->y1 < a2->y1 && a1->y2 <= a2->y2) a1->y2 = a2->y1 - 1;
+    }
+    /*'a1' is taller: remove the common columns from 'a2'*/
+    else if(a1->y1 <= a2->y1 && a1->y2 >= a2->y2) {
+        if(a1->x1 <= a2->x1) a2->x1 = a1->x2 + 1;
+        else a2->x2 = a1->x1 - 1;
+    }
+    /*'a2' is taller: remove the common columns from 'a1'*/
+    else if(a2->y1 <= a1->y1 && a2->y2 >= a1->y2) {
+        if(a2->x1 <= a1->x1) a1->x1 = a2->x2 + 1;
+        else a1->x2 = a2->x1 - 1;
     }
 }
 
@@ -227,7 +665,7 @@ static void lv_refr_areas(void)
             /*If VDB is used...*/
             lv_refr_area_with_vdb(&inv_buf[i].area);
 #endif
-            if(monitor_cb != NULL) px_num += area_get_size(&inv_buf[i].area);
+            px_num += area_get_size(&inv_buf[i].area);
         }
     }
 
@@ -257,35 +695,69 @@ static void lv_refr_area_no_vdb(const area_t * area_p)
  */
 static void lv_refr_area_with_vdb(const area_t * area_p)
 {
-    lv_vdb_t * vdb_p = lv_vdb_get();
-    
-    /*Always use the full row*/
-    vdb_p->area.x1 = area_p->x1;
-    vdb_p->area.y1 = area_p->y1;
-    vdb_p->area.x2 = area_p->x2;
+    lv_vdb_t * vdb_p;
 
     /*Calculate the max row num*/
-    uint32_t max_row = (uint32_t) LV_VDB_SIZE / (vdb_p->area.x2 - vdb_p->area.x1 + 1);
+    uint32_t max_row = (uint32_t) LV_VDB_SIZE / area_get_width(area_p);
     if(max_row > area_get_height(area_p)) max_row = area_get_height(area_p);
+
+#if LV_REFR_THREAD_NUM > 1 && LV_REFR_TILE_H != 0
+    /*Smaller bands to share the work between more threads*/
+    if(max_row > LV_REFR_TILE_H) max_row = LV_REFR_TILE_H;
+#endif
     
     /*Round the row number with downscale*/
 #if LV_DOWNSCALE == 2
     max_row &= (~0x1);
 #endif
 
+#if LV_DLIST_SIZE != 0
+    /*Run the design functions only once if the area is drawn in more parts
+     *and replay the recorded drawings in every part*/
+    dlist_ready = false;
+    if(max_row < area_get_height(area_p)) {
+        lv_dlist_start();
+        lv_refr_make(lv_refr_get_top_obj(area_p, lv_scr_act()), area_p);
+        dlist_ready = lv_dlist_stop();
+    }
+
+#if LV_REFR_THREAD_NUM > 1
+    /*Render the bands in parallel from the display list*/
+    if(dlist_ready != false) {
+        lv_tpool_render(area_p, max_row);
+        return;
+    }
+#endif
+#endif
+
     /*Refresh all rows*/
     cord_t row = area_p->y1;
+    cord_t row_last = 0;
 
     for(row = area_p->y1; row  + max_row - 1 <= area_p->y2; row += max_row)  {
+        /* Get the VDB for every part because in LV_VDB_DOUBLE mode
+         * an other VDB is used while the previous part is flushed */
+        vdb_p = lv_vdb_get();
+
+        /*Always use the full row*/
+        vdb_p->area.x1 = area_p->x1;
+        vdb_p->area.x2 = area_p->x2;
+
         /*Calc. the next y coordinates of VDB*/
         vdb_p->area.y1 = row;
         vdb_p->area.y2 = row + max_row - 1;
+        row_last = vdb_p->area.y2;
 
         lv_refr_area_part_vdb(area_p);
     }
     
     /*If the last y coordinates are not handled yet ...*/
-    if(area_p->y2 != vdb_p->area.y2) {
+    if(area_p->y2 != row_last) {
+        vdb_p = lv_vdb_get();
+
+        vdb_p->area.x1 = area_p->x1;
+        vdb_p->area.x2 = area_p->x2;
+
         /*Calc. the next y coordinates of VDB*/
         vdb_p->area.y1 = row;
         vdb_p->area.y2 = area_p->y2;
@@ -309,14 +781,25 @@ static void lv_refr_area_part_vdb(const area_t * area_p)
     area_t start_mask;
     area_union(&start_mask, area_p, &vdb_p->area);
 
-    /*Get the most top object which is not covered by others*/
-    top_p = lv_refr_get_top_obj(&start_mask, lv_scr_act());
+#if LV_DLIST_SIZE != 0
+    if(dlist_ready != false) {
+        lv_dlist_replay(&start_mask);
+    } else
+#endif
+    {
+        /*Get the most top object which is not covered by others*/
+        top_p = lv_refr_get_top_obj(&start_mask, lv_scr_act());
 
-    /*Do the refreshing from the top object*/
-    lv_refr_make(top_p, &start_mask);
+        /*Do the refreshing from the top object*/
+        lv_refr_make(top_p, &start_mask);
+    }
 
     /*Flush the content of the VDB*/ 
     lv_vdb_flush();
+
+#if LV_PROF != 0
+    lv_prof_band();
+#endif
 }
 
 #endif /*LV_VDB_SIZE == 0*/
@@ -335,6 +818,10 @@ static lv_obj_t * lv_refr_get_top_obj(const area_t * area_p, lv_obj_t * obj)
     /*If this object is fully cover the draw area check the children too */
     if(area_is_in(area_p, &obj->cords) && obj->hidden == 0)
     {
+#if LV_OBJ_LAYER != 0
+        /*The children of a layer are drawn with the layer*/
+        if(obj->layer_en == 0)
+#endif
         LL_READ(obj->child_ll, i)        {
             found_p = lv_refr_get_top_obj(area_p, i);
             
@@ -414,6 +901,14 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
 {
     /*Do not refresh hidden objects*/
     if(obj->hidden != 0) return;
+
+#if LV_OBJ_LAYER != 0
+    /*Draw the object and its children from the layer*/
+    if(obj->layer_en != 0 && obj != layer_obj) {
+        lv_refr_layer(obj, mask_ori_p);
+        return;
+    }
+#endif
     
     bool union_ok;  /* Store the return value of area_union */
     /* Truncate the original mask to the coordinates of the parent
@@ -435,7 +930,13 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
         /* Redraw the object */
         lv_style_t * style = lv_obj_get_style(obj);
         if(style->opa != OPA_TRANSP) {
+#if LV_PROF != 0
+            uint32_t prof_start = lv_prof_start();
+            obj->design_f(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+            lv_prof_obj_end(obj, prof_start);
+#else
             obj->design_f(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+#endif
             //tick_wait_ms(100);  /*DEBUG: Wait after every object draw to see the order of drawing*/
         }
 
@@ -446,8 +947,20 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
 			area_t mask_child; /*Mask from obj and its child*/
 			lv_obj_t * child_p;
 			area_t child_area;
+#if LV_REFR_OCCL_NUM != 0
+			/*Collect the opaque children. The children which are under them are not drawn.
+			 * Only the first 'occl_act' elements are younger (on top) than 'child_p'*/
+			lv_occl_t occl[LV_REFR_OCCL_NUM];
+			uint8_t occl_act = lv_refr_occl_collect(obj, &obj_mask, occl);
+#endif
 			LL_READ_BACK(obj->child_ll, child_p)
 			{
+#if LV_REFR_OCCL_NUM != 0
+				/*An occluder does not cover itself and the older children*/
+				if(occl_act != 0 && occl[occl_act - 1].obj == child_p) {
+					occl_act--;
+				}
+#endif
 				lv_obj_get_cords(child_p, &child_area);
 				ext_size = child_p->ext_size;
 				child_area.x1 -= ext_size;
@@ -457,6 +970,12 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
 				/* Get the union (common parts) of original mask (from obj)
 				 * and its child */
 				union_ok = area_union(&mask_child, &obj_mask, &child_area);
+#if LV_REFR_OCCL_NUM != 0
+				/*Skip or reduce the child if younger siblings cover it*/
+				if(union_ok != false) {
+					union_ok = lv_refr_occl_clip(&mask_child, occl, occl_act);
+				}
+#endif
 
 				/*If the parent and the child has common area then refresh the child */
 				if(union_ok) {
@@ -468,7 +987,192 @@ static void lv_refr_obj(lv_obj_t * obj, const area_t * mask_ori_p)
 
         /* If all the children are redrawn make 'post draw' design */
         if(style->opa != OPA_TRANSP) {
-		  obj->design_f(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+#if LV_PROF != 0
+            uint32_t prof_start = lv_prof_start();
+            obj->design_f(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+            lv_prof_obj_end(obj, prof_start);
+#else
+            obj->design_f(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+#endif
 		}
     }
 }
+
+#if LV_OBJ_LAYER != 0
+/**
+ * Draw an object and its children from the layer of the object.
+ * Render them into the layer first if it's not valid.
+ * @param obj pointer to an object with enabled layer
+ * @param mask_p pointer to an area, the object will be drawn only here
+ */
+static void lv_refr_layer(lv_obj_t * obj, const area_t * mask_p)
+{
+    lv_obj_t * layer_obj_prev = layer_obj;
+    lv_style_t * style = lv_obj_get_style(obj);
+    area_t layer_area;
+    lv_obj_get_cords(obj, &layer_area);
+
+    /* The layer has no opacity so it can store only opaque pixels.
+     * Draw the object directly if it doesn't cover its area
+     * (e.g. transparent or rounded body, the children would be mixed with an unknown background)*/
+    if(style->opa != OPA_COVER ||
+       obj->design_f(obj, &layer_area, LV_DESIGN_COVER_CHK) == false) {
+        layer_obj = obj;
+        lv_refr_obj(obj, mask_p);
+        layer_obj = layer_obj_prev;
+        return;
+    }
+
+    if(obj->layer_valid == 0 || obj->layer_buf == NULL) {
+        /*Allocate a new buffer if the object became larger*/
+        uint32_t layer_px = area_get_size(&layer_area);
+        if(obj->layer_px < layer_px) {
+            if(obj->layer_buf != NULL) dm_free(obj->layer_buf);
+            obj->layer_buf = dm_alloc(layer_px * sizeof(color_t));
+            obj->layer_px = obj->layer_buf != NULL ? layer_px : 0;
+        }
+
+        /*Without enough memory draw the object directly*/
+        if(obj->layer_buf == NULL) {
+            layer_obj = obj;
+            lv_refr_obj(obj, mask_p);
+            layer_obj = layer_obj_prev;
+            return;
+        }
+
+        /* Redirect the drawing into the layer and render the object with its children.
+         * The object covers the layer so it needn't to be cleared.*/
+        lv_vdb_t layer;
+        area_cpy(&layer.area, &layer_area);
+        layer.buf = obj->layer_buf;
+        layer.state = LV_VDB_STATE_ACTIVE;
+        lv_vdb_t * layer_prev = lv_vdb_set_layer(&layer);
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+        /*The layer is drawn now, only its map is recorded*/
+        bool dlist_rec = lv_dlist_pause();
+#endif
+
+        layer_obj = obj;
+        lv_refr_obj(obj, &layer_area);
+        layer_obj = layer_obj_prev;
+
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+        if(dlist_rec != false) lv_dlist_resume();
+#endif
+        lv_vdb_set_layer(layer_prev);
+        obj->layer_valid = 1;
+    }
+
+    /*The shadow (out of the object) is semi transparent so it is not in the layer*/
+    if(obj->ext_size != 0) lv_refr_layer_ext(obj, mask_p);
+
+#if LV_VDB_SIZE != 0 && LV_DLIST_SIZE != 0
+    if(lv_dlist_rec_map(&layer_area, mask_p, obj->layer_buf, OPA_COVER, false, false, COLOR_BLACK, OPA_TRANSP) != false) return;
+#endif
+
+    lv_vmap(&layer_area, mask_p, obj->layer_buf, OPA_COVER, false, false, COLOR_BLACK, OPA_TRANSP);
+}
+
+/**
+ * Draw the part of a layered object which is out of its coordinates (in 'ext_size', e.g. the shadow)
+ * @param obj pointer to an object with enabled layer
+ * @param mask_p pointer to an area, the object will be drawn only here
+ */
+static void lv_refr_layer_ext(lv_obj_t * obj, const area_t * mask_p)
+{
+    cord_t ext_size = obj->ext_size;
+    area_t ext_a[4];
+    area_t mask;
+    uint8_t i;
+
+    /*Top, bottom, left and right stripes around the object*/
+    for(i = 0; i < 4; i++) lv_obj_get_cords(obj, &ext_a[i]);
+    ext_a[0].x1 -= ext_size;
+    ext_a[0].x2 += ext_size;
+    ext_a[0].y2 = ext_a[0].y1 - 1;
+    ext_a[0].y1 -= ext_size;
+
+    ext_a[1].x1 -= ext_size;
+    ext_a[1].x2 += ext_size;
+    ext_a[1].y1 = ext_a[1].y2 + 1;
+    ext_a[1].y2 += ext_size;
+
+    ext_a[2].x2 = ext_a[2].x1 - 1;
+    ext_a[2].x1 -= ext_size;
+
+    ext_a[3].x1 = ext_a[3].x2 + 1;
+    ext_a[3].x2 += ext_size;
+
+    for(i = 0; i < 4; i++) {
+        if(area_union(&mask, mask_p, &ext_a[i]) == false) continue;
+
+        /*There are no children out of the object, only the object is drawn*/
+        obj->design_f(obj, &mask, LV_DESIGN_DRAW_MAIN);
+        obj->design_f(obj, &mask, LV_DESIGN_DRAW_POST);
+    }
+}
+#endif
+
+#if LV_REFR_OCCL_NUM != 0
+/**
+ * Collect the youngest children of an object which fully cover their area on a mask
+ * @param obj pointer to an object whose children should be checked
+ * @param mask_p the mask of 'obj' (without 'ext_size')
+ * @param occl array to store the covering children (youngest first). Size: LV_REFR_OCCL_NUM
+ * @return number of elements stored in 'occl'
+ */
+static uint8_t lv_refr_occl_collect(lv_obj_t * obj, const area_t * mask_p, lv_occl_t * occl)
+{
+    uint8_t occl_num = 0;
+    lv_obj_t * child_p;
+    area_t child_area;
+
+    LL_READ(obj->child_ll, child_p) {
+        if(occl_num >= LV_REFR_OCCL_NUM) break;
+        if(child_p->hidden != 0) continue;
+
+        lv_obj_get_cords(child_p, &child_area);
+        if(area_union(&occl[occl_num].area, mask_p, &child_area) == false) continue;
+
+        lv_style_t * style = lv_obj_get_style(child_p);
+        if(style->opa == OPA_COVER &&
+           child_p->design_f(child_p, &occl[occl_num].area, LV_DESIGN_COVER_CHK) != false) {
+            occl[occl_num].obj = child_p;
+            occl_num++;
+        }
+    }
+
+    return occl_num;
+}
+
+/**
+ * Reduce a mask with the areas covered by opaque objects
+ * @param mask_p pointer to a mask to reduce. Only whole rows or columns are removed
+ *               to keep it rectangular
+ * @param occl array of covering objects (from 'lv_refr_occl_collect')
+ * @param occl_num number of elements in 'occl' to consider
+ * @return false: the mask is fully covered (nothing to draw), true: the mask has visible parts
+ */
+static bool lv_refr_occl_clip(area_t * mask_p, const lv_occl_t * occl, uint8_t occl_num)
+{
+    uint8_t i;
+    for(i = 0; i < occl_num; i++) {
+        const area_t * o = &occl[i].area;
+        if(area_is_on(mask_p, o) == false) continue;
+        if(area_is_in(mask_p, o) != false) return false;
+
+        /*The occluder spans the whole width: cut the covered rows from the top or bottom*/
+        if(o->x1 <= mask_p->x1 && o->x2 >= mask_p->x2) {
+            if(o->y1 <= mask_p->y1) mask_p->y1 = o->y2 + 1;
+            else if(o->y2 >= mask_p->y2) mask_p->y2 = o->y1 - 1;
+        }
+        /*The occluder spans the whole height: cut the covered columns from the left or right*/
+        else if(o->y1 <= mask_p->y1 && o->y2 >= mask_p->y2) {
+            if(o->x1 <= mask_p->x1) mask_p->x1 = o->x2 + 1;
+            else if(o->x2 >= mask_p->x2) mask_p->x2 = o->x1 - 1;
+        }
+    }
+
+    return true;
+}
+#endif
@@ -16,6 +16,9 @@ extern "C" {
 #include "lv_obj.h"
 #include <stdbool.h>
 
+#ifndef LV_REFR_FRAME_SYNC
+#define LV_REFR_FRAME_SYNC      0
+#endif
 
 /*********************
  *      DEFINES
@@ -24,6 +27,15 @@ extern "C" {
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_REFR_FRAME_SYNC != 0
+typedef struct
+{
+    uint32_t frame_num;     /*Number of refreshed frames*/
+    uint32_t skip_num;      /*Number of frames skipped because nothing was invalid*/
+    uint32_t late_num;      /*Number of frames which took longer than LV_REFR_PERIOD*/
+    uint32_t drop_num;      /*Number of missed frame periods (the frame task was started too late)*/
+}lv_refr_frame_stat_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -47,7 +59,8 @@ extern "C" {
 void lv_refr_init(void);
 
 /**
- * Invalidate an area
+ * Invalidate an area. The layers of the objects are not invalidated,
+ * use 'lv_obj_inv_area' to redraw a part of an object.
  * @param area_p pointer to area which should be invalidated
  */
 void lv_inv_area(const area_t * area_p);
@@ -58,6 +71,50 @@ void lv_inv_area(const area_t * area_p);
  */
 void lv_refr_set_monitor_cb(void (*cb)(uint32_t, uint32_t));
 
+#if LV_OBJ_MOVE_COPY != 0
+/**
+ * Set a function to copy an area of the display to an other position.
+ * It is used to move the drawn pixels instead of redrawing them (see 'lv_obj_set_move_copy').
+ * @param cb pointer to a callback function (bool my_copy_cb(const area_t * area_p, cord_t dx, cord_t dy))
+ *           area_p: the area to copy in display coordinates
+ *           dx, dy: copy 'area_p' to here relative to its original position. The areas can overlap.
+ *           return: true: the pixels are copied; false: the copy is not possible (the area will be redrawn)
+ */
+void lv_refr_set_copy_cb(bool (*cb)(const area_t *, cord_t, cord_t));
+
+/**
+ * Move the drawn pixels of an area in the next refresh instead of redrawing them.
+ * The newly exposed parts of the area are invalidated.
+ * Only one area can be moved in a refresh period (but the same area more times)
+ * @param area_p pointer to the area which content is moved
+ * @param dx horizontal movement
+ * @param dy vertical movement
+ * @return true: the move is saved; false: the move is not possible so invalidate the area instead
+ */
+bool lv_refr_move_area(const area_t * area_p, cord_t dx, cord_t dy);
+#endif
+
+/**
+ * Redraw the invalidated areas now instead of waiting for the periodic refresh task
+ * (e.g. to refresh during a long blocking process or to drive the drawing from a test or benchmark)
+ */
+void lv_refr_now(void);
+
+#if LV_REFR_FRAME_SYNC != 0
+/**
+ * Start the next frame at the next 'ptask_handler' call instead of waiting for LV_REFR_PERIOD.
+ * Call it on the vertical sync. or tearing effect signal of the display
+ * (from the context of 'ptask_handler', e.g. after the interrupt set a flag)
+ */
+void lv_refr_vsync(void);
+
+/**
+ * Get the statistics of the frames
+ * @param stat pointer to a 'lv_refr_frame_stat_t' variable to store the result
+ */
+void lv_refr_get_frame_stat(lv_refr_frame_stat_t * stat);
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
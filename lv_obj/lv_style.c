@@ -60,6 +60,7 @@ void lv_style_init (void)
 
     lv_style_scr.mcolor = COLOR_MAKE(0xc9, 0xdb, 0xee);
     lv_style_scr.gcolor = COLOR_MAKE(0x4d, 0x91, 0xd5);
+    lv_style_scr.gdir = LV_GDIR_VER;
     lv_style_scr.bcolor = COLOR_BLACK;
     lv_style_scr.scolor = COLOR_GRAY;
     lv_style_scr.radius = 0;
@@ -40,6 +40,13 @@ typedef enum
     LV_STYPE_FULL,
 }lv_stype_t;
 
+/*Gradient directions*/
+typedef enum
+{
+    LV_GDIR_VER = 0,    /*'mcolor' on the top, 'gcolor' on the bottom*/
+    LV_GDIR_HOR,        /*'mcolor' on the left, 'gcolor' on the right*/
+}lv_gdir_t;
+
 typedef struct
 {
     /*Object level styles*/
@@ -49,6 +56,7 @@ typedef struct
     uint8_t empty :1;   /*Transparent background (border drawn)*/
     uint8_t stype :2;   /*Shadow type from 'lv_shadow_type_t'*/
     uint8_t txt_align:2;
+    uint8_t gdir :1;    /*Gradient direction from 'lv_gdir_t'*/
     color_t mcolor;     /*Main color of background*/
     color_t gcolor;     /*Gradient color of background*/
     color_t bcolor;     /*Border color of background*/
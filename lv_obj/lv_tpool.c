@@ -0,0 +1,208 @@
+/**
+ * @file lv_tpool.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_tpool.h"
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "hal/disp/disp.h"
+#include "lv_vdb.h"
+#include "lv_prof.h"
+#include "../lv_draw/lv_dlist.h"
+
+#if DISP_HW_ACC != 0
+#error "lv_tpool: LV_REFR_THREAD_NUM > 1 is not supported with DISP_HW_ACC"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * lv_tpool_worker(void * param);
+static void lv_tpool_render_band(uint8_t id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static color_t band_buf[LV_REFR_THREAD_NUM][LV_VDB_SIZE];
+static lv_vdb_t band_a[LV_REFR_THREAD_NUM];    /*The band of every thread (the caller's is the first)*/
+static uint8_t band_num;                        /*Number of bands in the actual job*/
+static uint8_t thread_num;                      /*Number of the started threads + the caller*/
+static pthread_t thread_a[LV_REFR_THREAD_NUM - 1];
+static pthread_mutex_t job_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t start_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t job_id;                         /*Incremented to start a new job*/
+static uint8_t busy_cnt;                        /*Number of workers still rendering the actual job*/
+static bool job_busy;                           /*A job is being rendered*/
+static pthread_mutex_t res_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start the worker threads (LV_REFR_THREAD_NUM - 1, the caller of 'lv_tpool_render' is the last one)
+ */
+void lv_tpool_init(void)
+{
+    uint8_t i;
+    for(i = 0; i < LV_REFR_THREAD_NUM; i++) {
+        band_a[i].buf = band_buf[i];
+        band_a[i].state = LV_VDB_STATE_ACTIVE;
+    }
+
+    /*Render with less threads if some of them can't be started*/
+    thread_num = 1;
+    for(i = 0; i < LV_REFR_THREAD_NUM - 1; i++) {
+        if(pthread_create(&thread_a[i], NULL, lv_tpool_worker, (void *)(uintptr_t) thread_num) != 0) break;
+        thread_num ++;
+    }
+}
+
+/**
+ * Render an area from the recorded display list in bands in parallel
+ * and flush the bands in order from the calling thread
+ * @param area_p pointer to the area to refresh
+ * @param band_h height of the bands (fits into the VDB)
+ */
+void lv_tpool_render(const area_t * area_p, cord_t band_h)
+{
+    cord_t row = area_p->y1;
+    uint8_t i;
+
+    while(row <= area_p->y2) {
+        /*The bands of the previous job has to be flushed before drawing into them again*/
+        lv_vdb_wait_flush();
+
+        /*Give a band to every thread*/
+        for(i = 0; i < thread_num && row <= area_p->y2; i++) {
+            band_a[i].area.x1 = area_p->x1;
+            band_a[i].area.x2 = area_p->x2;
+            band_a[i].area.y1 = row;
+            band_a[i].area.y2 = row + band_h - 1;
+            if(band_a[i].area.y2 > area_p->y2) band_a[i].area.y2 = area_p->y2;
+            band_a[i].state = LV_VDB_STATE_ACTIVE;
+            row += band_h;
+        }
+        band_num = i;
+
+        /*Start the workers and render the first band meanwhile*/
+        pthread_mutex_lock(&job_mutex);
+        busy_cnt = thread_num - 1;
+        job_busy = true;
+        job_id ++;
+        pthread_cond_broadcast(&start_cond);
+        pthread_mutex_unlock(&job_mutex);
+
+        lv_tpool_render_band(0);
+
+        pthread_mutex_lock(&job_mutex);
+        while(busy_cnt != 0) pthread_cond_wait(&done_cond, &job_mutex);
+        job_busy = false;
+        pthread_mutex_unlock(&job_mutex);
+
+        /*Flush the bands from top to bottom*/
+        for(i = 0; i < band_num; i++) {
+            lv_vdb_t * vdb_prev = lv_vdb_set_layer(&band_a[i]);
+            lv_vdb_flush();
+            lv_vdb_set_layer(vdb_prev);
+#if LV_PROF != 0
+            lv_prof_band();
+#endif
+        }
+    }
+}
+
+/**
+ * Tell whether the bands are being rendered in parallel
+ * @return true: the drawing functions can run on more threads now
+ */
+bool lv_tpool_busy(void)
+{
+    return job_busy;
+}
+
+/**
+ * Lock the resources which are shared by the threads during the rendering
+ * (e.g. file system, dynamic memory)
+ */
+void lv_tpool_lock(void)
+{
+    pthread_mutex_lock(&res_mutex);
+}
+
+/**
+ * Unlock the shared resources locked by 'lv_tpool_lock'
+ */
+void lv_tpool_unlock(void)
+{
+    pthread_mutex_unlock(&res_mutex);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * The function of the worker threads. Render a band in every job.
+ * @param param the index of the thread's band in 'band_a'
+ * @return never returns
+ */
+static void * lv_tpool_worker(void * param)
+{
+    uint8_t id = (uintptr_t) param;
+    uint32_t job_last = 0;
+
+    while(1) {
+        pthread_mutex_lock(&job_mutex);
+        while(job_id == job_last) pthread_cond_wait(&start_cond, &job_mutex);
+        job_last = job_id;
+        pthread_mutex_unlock(&job_mutex);
+
+        /*The last job can have less bands than threads*/
+        if(id < band_num) lv_tpool_render_band(id);
+
+        pthread_mutex_lock(&job_mutex);
+        busy_cnt --;
+        if(busy_cnt == 0) pthread_cond_signal(&done_cond);
+        pthread_mutex_unlock(&job_mutex);
+    }
+
+    return NULL;
+}
+
+/**
+ * Replay the display list into the band of a thread.
+ * Only the recorded drawings are used, the objects are not accessed by the workers.
+ * @param id index of the band in 'band_a'
+ */
+static void lv_tpool_render_band(uint8_t id)
+{
+    /*The drawing functions draw into the VDB of the actual thread*/
+    lv_vdb_t * vdb_prev = lv_vdb_set_layer(&band_a[id]);
+    lv_dlist_replay(&band_a[id].area);
+    lv_vdb_set_layer(vdb_prev);
+}
+
+#endif /*LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1*/
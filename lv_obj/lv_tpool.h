@@ -0,0 +1,88 @@
+/**
+ * @file lv_tpool.h
+ * Worker threads to render the VDB bands of the large areas in parallel
+ */
+
+#ifndef LV_TPOOL_H
+#define LV_TPOOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_REFR_THREAD_NUM
+#define LV_REFR_THREAD_NUM  0
+#endif
+
+#ifndef LV_REFR_TILE_H
+#define LV_REFR_TILE_H      0
+#endif
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1
+
+#include <stdbool.h>
+#include "misc/gfx/area.h"
+#include "../lv_draw/lv_dlist.h"
+
+#if LV_DLIST_SIZE == 0
+#error "lv_tpool: LV_REFR_THREAD_NUM > 1 requires the display list (LV_DLIST_SIZE != 0)"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start the worker threads (LV_REFR_THREAD_NUM - 1, the caller of 'lv_tpool_render' is the last one)
+ */
+void lv_tpool_init(void);
+
+/**
+ * Render an area from the recorded display list in bands in parallel
+ * and flush the bands in order from the calling thread
+ * @param area_p pointer to the area to refresh
+ * @param band_h height of the bands (fits into the VDB)
+ */
+void lv_tpool_render(const area_t * area_p, cord_t band_h);
+
+/**
+ * Tell whether the bands are being rendered in parallel
+ * @return true: the drawing functions can run on more threads now
+ */
+bool lv_tpool_busy(void);
+
+/**
+ * Lock the resources which are shared by the threads during the rendering
+ * (e.g. file system, dynamic memory)
+ */
+void lv_tpool_lock(void);
+
+/**
+ * Unlock the shared resources locked by 'lv_tpool_lock'
+ */
+void lv_tpool_unlock(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*LV_VDB_SIZE != 0 && LV_REFR_THREAD_NUM > 1*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_TPOOL_H*/
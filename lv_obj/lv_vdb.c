@@ -8,6 +8,8 @@
 #include "hal/disp/disp.h"
 #include <stddef.h>
 #include "lv_vdb.h"
+#include "lv_prof.h"
+#include "lv_tpool.h"
 
 /*********************
  *      INCLUDES
@@ -16,6 +18,17 @@
 /*********************
  *      DEFINES
  *********************/
+/* Change the state of the buffers between the rendering and the flushing
+ * (from an other thread or interrupt) with acquire-release ordering:
+ * the pixels are written (read) before the new state can be seen.
+ * Redefine them in lv_conf.h if the compiler has no '__atomic' built-ins*/
+#ifndef LV_VDB_ATOMIC_LOAD
+#define LV_VDB_ATOMIC_LOAD(var)          __atomic_load_n(&(var), __ATOMIC_ACQUIRE)
+#endif
+
+#ifndef LV_VDB_ATOMIC_STORE
+#define LV_VDB_ATOMIC_STORE(var, value)  __atomic_store_n(&(var), (value), __ATOMIC_RELEASE)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -24,11 +37,35 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_ANTIALIAS != 0
+static void lv_vdb_downscale(lv_vdb_t * vdb_p, color_t * out_buf);
+static void lv_vdb_downscale_row(color_t * out_buf, const color_t * in1_buf, const color_t * in2_buf, cord_t out_w);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_vdb_t vdb;
+#if LV_VDB_DOUBLE == 0
+static color_t vdb_buf[LV_VDB_SIZE];
+static lv_vdb_t vdb = {{0, 0, 0, 0}, vdb_buf, LV_VDB_STATE_FREE};
+#else
+static color_t vdb_buf[2][LV_VDB_SIZE];
+static lv_vdb_t vdb[2] = {{{0, 0, 0, 0}, vdb_buf[0], LV_VDB_STATE_FREE},
+                          {{0, 0, 0, 0}, vdb_buf[1], LV_VDB_STATE_FREE}};
+#endif
+#if LV_REFR_THREAD_NUM > 1
+static __thread lv_vdb_t * layer_act;   /*Per thread to render the bands in parallel (see 'lv_tpool')*/
+#else
+static lv_vdb_t * layer_act;    /*Draw into this instead of the VDB if not NULL*/
+#endif
+#if LV_VDB_DOUBLE != 0
+static lv_vdb_t * volatile flush_act;   /*The VDB being flushed (NULL if none)*/
+#endif
+
+#if LV_ANTIALIAS != 0 && LV_VDB_OUT_BUF != 0
+static color_t out_buf[LV_VDB_SIZE / 4];
+static volatile uint8_t out_state;  /*State of 'out_buf' from 'lv_vdb_state_t'*/
+#endif
 
 /**********************
  *      MACROS
@@ -39,12 +76,35 @@ static lv_vdb_t vdb;
  **********************/
 
 /**
- * Get the vdb variable
- * @return pointer to the vdb variable
+ * Get the 'vdb' variable or allocate one in LV_VDB_DOUBLE mode
+ * (wait until a VDB becomes free if both are in use)
+ * @return pointer to a 'vdb' variable
  */
 lv_vdb_t * lv_vdb_get(void)
 {
+    if(layer_act != NULL) return layer_act;
+
+#if LV_VDB_DOUBLE == 0
     return &vdb;
+#else
+    /*If already there is an active do nothing*/
+    if(LV_VDB_ATOMIC_LOAD(vdb[0].state) == LV_VDB_STATE_ACTIVE) return &vdb[0];
+    if(LV_VDB_ATOMIC_LOAD(vdb[1].state) == LV_VDB_STATE_ACTIVE) return &vdb[1];
+
+    /* Wait for a free VDB. One of them is flushed now,
+     * the display driver will free it with 'lv_vdb_flush_ready()'*/
+    while(1) {
+        if(LV_VDB_ATOMIC_LOAD(vdb[0].state) == LV_VDB_STATE_FREE) {
+            vdb[0].state = LV_VDB_STATE_ACTIVE;
+            return &vdb[0];
+        }
+
+        if(LV_VDB_ATOMIC_LOAD(vdb[1].state) == LV_VDB_STATE_FREE) {
+            vdb[1].state = LV_VDB_STATE_ACTIVE;
+            return &vdb[1];
+        }
+    }
+#endif
 }
 
 /**
@@ -52,63 +112,192 @@ lv_vdb_t * lv_vdb_get(void)
  */
 void lv_vdb_flush(void)
 {
+    lv_vdb_t * vdb_act = lv_vdb_get();
+
+#if LV_PROF != 0
+    uint32_t prof_start = lv_prof_start();
+#endif
+
+#if LV_ANTIALIAS != 0 && LV_VDB_OUT_BUF != 0
+    /* Downscale into the output buffer when its previous content is flushed.
+     * The VDB can be used again to render the next part while 'out_buf' is flushed*/
+    lv_vdb_wait_flush();
+    lv_vdb_downscale(vdb_act, out_buf);
+    LV_VDB_ATOMIC_STORE(out_state, LV_VDB_STATE_FLUSH);
+#if LV_VDB_DOUBLE != 0
+    vdb_act->state = LV_VDB_STATE_FREE;
+#endif
+    disp_map(vdb_act->area.x1 >> 1, vdb_act->area.y1 >> 1, vdb_act->area.x2 >> 1, vdb_act->area.y2 >> 1, out_buf);
+#else
+
+#if LV_ANTIALIAS != 0
+    /*Downscale the content of the VDB into its first quarter*/
+    lv_vdb_downscale(vdb_act, vdb_act->buf);
+#endif
+
+#if LV_VDB_DOUBLE != 0
+    /* Only one flush can be in progress. Wait the pending flush before starting this one
+     * (the display driver has to call 'lv_vdb_flush_ready()' when it is ready)*/
+    lv_vdb_wait_flush();
+
+    vdb_act->state = LV_VDB_STATE_FLUSH;
+    LV_VDB_ATOMIC_STORE(flush_act, vdb_act);
+#endif
+
+    /* Write out the map to the display.
+     * In LV_VDB_DOUBLE mode 'disp_map()' should only start the transfer (e.g. with DMA)
+     * and return immediately to render the next part in the other VDB meanwhile*/
 #if LV_ANTIALIAS == 0
-	disp_map(vdb.area.x1, vdb.area.y1, vdb.area.x2, vdb.area.y2, vdb.buf);
+    disp_map(vdb_act->area.x1, vdb_act->area.y1, vdb_act->area.x2, vdb_act->area.y2, vdb_act->buf);
 #else
-	/* Get the average of 2x2 pixels and put the result back to the VDB
-	 * The reading goes much faster then the write back
-	 * so useful data won't be overwritten
-	 * Example:
-	 * -----------------------------
-	 * in1_buf  |2,2|6,8|      3,7
-	 * in2_buf  |4,4|7,7|      1,2
-	 *           ---------  ==>
-	 * in1_buf  |1,1|1,3|
-	 * in2_buf  |1,1|1,3|
-	 * */
-	cord_t x;
-	cord_t y;
-	cord_t w = area_get_width(&vdb.area);
-	color_t * in1_buf = vdb.buf;      /*Pointer to the first row*/
-    color_t * in2_buf = vdb.buf + w;  /*Pointer to the second row*/
-    color_t * out_buf = vdb.buf;      /*Store the result here*/
-	for(y = vdb.area.y1; y < vdb.area.y2; y += 2) {
-        for(x = vdb.area.x1; x < vdb.area.x2; x += 2) {
-        
-            /*If the pixels are the same do not calculate the average */
-            if(in1_buf->full == (in1_buf + 1)->full &&
-               in1_buf->full == in2_buf->full &&
-               in1_buf->full == (in2_buf + 1)->full) {
-                out_buf->full = in1_buf->full;
-            } else {
-                /*Get the average of 2x2 red*/
-                out_buf->red = (in1_buf->red + (in1_buf + 1)->red +
-                                in2_buf->red + (in2_buf+ 1)->red) >> 2;
-                /*Get the average of 2x2 green*/
-                out_buf->green = (in1_buf->green + (in1_buf + 1)->green +
-                                  in2_buf->green + (in2_buf + 1)->green) >> 2;
-                /*Get the average of 2x2 blue*/
-                out_buf->blue = (in1_buf->blue + (in1_buf + 1)->blue +
-                                 in2_buf->blue + (in2_buf + 1)->blue) >> 2;
-            }
-            
-			in1_buf += 2; /*Skip the next pixel because it is already used above*/
-            in2_buf += 2;
-			out_buf ++;
-		}
-		/*2 row is ready so go the next 2*/
-		in1_buf += w; /*Skip the next row because it is processed from in2_buf*/
-        in2_buf += w;
-	}
-
-	/* Now the full the VDB is filtered and the result is stored in the first quarter of it
-	 * Write out the filtered map to the display*/
-    disp_map(vdb.area.x1 >> 1, vdb.area.y1 >> 1, vdb.area.x2 >> 1, vdb.area.y2 >> 1, vdb.buf);
+    disp_map(vdb_act->area.x1 >> 1, vdb_act->area.y1 >> 1, vdb_act->area.x2 >> 1, vdb_act->area.y2 >> 1, vdb_act->buf);
+#endif
+#endif /*LV_ANTIALIAS != 0 && LV_VDB_OUT_BUF != 0*/
+
+#if LV_PROF != 0
+    lv_prof_prim_end(LV_PROF_PRIM_FLUSH, prof_start);
 #endif
 }
 
+/**
+ * Wait until all the VDBs are flushed
+ */
+void lv_vdb_wait_flush(void)
+{
+#if LV_VDB_DOUBLE != 0
+    while(LV_VDB_ATOMIC_LOAD(flush_act) != NULL);
+#endif
+
+#if LV_ANTIALIAS != 0 && LV_VDB_OUT_BUF != 0
+    while(LV_VDB_ATOMIC_LOAD(out_state) == LV_VDB_STATE_FLUSH);
+#endif
+}
+
+/**
+ * In 'LV_VDB_DOUBLE' or 'LV_VDB_OUT_BUF' mode has to be called when 'disp_map()'
+ * is ready with copying the map to a frame buffer.
+ * (Can be called from an interrupt or from an other thread)
+ */
+void lv_vdb_flush_ready(void)
+{
+#if LV_VDB_DOUBLE != 0
+    /*Not only 'vdb' can be flushed but the bands of 'lv_tpool' too*/
+    lv_vdb_t * vdb_flushed = LV_VDB_ATOMIC_LOAD(flush_act);
+    if(vdb_flushed != NULL) {
+        LV_VDB_ATOMIC_STORE(vdb_flushed->state, LV_VDB_STATE_FREE);
+        LV_VDB_ATOMIC_STORE(flush_act, NULL);
+    }
+#endif
+
+#if LV_ANTIALIAS != 0 && LV_VDB_OUT_BUF != 0
+    LV_VDB_ATOMIC_STORE(out_state, LV_VDB_STATE_FREE);
+#endif
+}
+
+/**
+ * Redirect the drawing into an other buffer (e.g. to render an object into its layer).
+ * 'lv_vdb_get()' will return 'layer' until the previous one is set back.
+ * @param layer pointer to a VDB with the buffer and its area (NULL to draw into the VDB again)
+ * @return the previously set layer (or NULL). Set it back when the drawing is ready.
+ */
+lv_vdb_t * lv_vdb_set_layer(lv_vdb_t * layer)
+{
+    lv_vdb_t * prev = layer_act;
+    layer_act = layer;
+    return prev;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_ANTIALIAS != 0
+/**
+ * Get the average of 2x2 pixels of a VDB
+ * @param vdb_p pointer to a VDB to downscale
+ * @param out_buf store the result here. Can be 'vdb_p->buf' too to downscale in place
+ */
+static void lv_vdb_downscale(lv_vdb_t * vdb_p, color_t * out_buf)
+{
+    /* The reading goes much faster then the write back
+     * so useful data won't be overwritten if 'out_buf' is 'vdb_p->buf'
+     * Example:
+     * -----------------------------
+     * in1_buf  |2,2|6,8|      3,7
+     * in2_buf  |4,4|7,7|      1,2
+     *           ---------  ==>
+     * in1_buf  |1,1|1,3|
+     * in2_buf  |1,1|1,3|
+     * */
+    cord_t y;
+    cord_t w = area_get_width(&vdb_p->area);
+    cord_t out_w = w >> 1;
+    const color_t * in1_buf = vdb_p->buf;      /*Pointer to the first row*/
+    const color_t * in2_buf = vdb_p->buf + w;  /*Pointer to the second row*/
+    for(y = vdb_p->area.y1; y < vdb_p->area.y2; y += 2) {
+        lv_vdb_downscale_row(out_buf, in1_buf, in2_buf, out_w);
+
+        /*2 row is ready so go the next 2*/
+        in1_buf += 2 * w;
+        in2_buf += 2 * w;
+        out_buf += out_w;
+    }
+}
+
+/**
+ * Get the average of 2x2 pixels in two rows
+ * @param out_buf store the 'out_w' result pixels here (can be the same as 'in1_buf')
+ * @param in1_buf pointer to the first row (2 * 'out_w' pixels)
+ * @param in2_buf pointer to the second row (2 * 'out_w' pixels)
+ * @param out_w number of pixels to create
+ */
+static void lv_vdb_downscale_row(color_t * out_buf, const color_t * in1_buf, const color_t * in2_buf, cord_t out_w)
+{
+    cord_t x;
+    for(x = 0; x < out_w; x++) {
+        /*If the pixels are the same do not calculate the average */
+        if(in1_buf->full == (in1_buf + 1)->full &&
+           in1_buf->full == in2_buf->full &&
+           in1_buf->full == (in2_buf + 1)->full) {
+            out_buf->full = in1_buf->full;
+        } else {
+#if COLOR_DEPTH == 16
+            /* Spread the channels of the pixels in a word (-----GGGGGG-----RRRRR------BBBBB)
+             * to leave space above them for the sum of 4 pixels and add them together*/
+            uint32_t sum;
+            sum  = (in1_buf->full | ((uint32_t)in1_buf->full << 16)) & 0x07E0F81F;
+            sum += ((in1_buf + 1)->full | ((uint32_t)(in1_buf + 1)->full << 16)) & 0x07E0F81F;
+            sum += (in2_buf->full | ((uint32_t)in2_buf->full << 16)) & 0x07E0F81F;
+            sum += ((in2_buf + 1)->full | ((uint32_t)(in2_buf + 1)->full << 16)) & 0x07E0F81F;
+            sum = (sum >> 2) & 0x07E0F81F;
+            out_buf->full = (sum & 0xF81F) | (sum >> 16);
+#elif COLOR_DEPTH == 24
+            /*Add the red and blue channels in one word and the green in an other*/
+            uint32_t rb;
+            uint32_t g;
+            rb = (in1_buf->full & 0x00FF00FF) + ((in1_buf + 1)->full & 0x00FF00FF) +
+                 (in2_buf->full & 0x00FF00FF) + ((in2_buf + 1)->full & 0x00FF00FF);
+            g = (in1_buf->full & 0x0000FF00) + ((in1_buf + 1)->full & 0x0000FF00) +
+                (in2_buf->full & 0x0000FF00) + ((in2_buf + 1)->full & 0x0000FF00);
+            out_buf->full = (in1_buf->full & 0xFF000000) | ((rb >> 2) & 0x00FF00FF) | ((g >> 2) & 0x0000FF00);
+#else
+            /*Get the average of 2x2 red*/
+            out_buf->red = (in1_buf->red + (in1_buf + 1)->red +
+                            in2_buf->red + (in2_buf+ 1)->red) >> 2;
+            /*Get the average of 2x2 green*/
+            out_buf->green = (in1_buf->green + (in1_buf + 1)->green +
+                              in2_buf->green + (in2_buf + 1)->green) >> 2;
+            /*Get the average of 2x2 blue*/
+            out_buf->blue = (in1_buf->blue + (in1_buf + 1)->blue +
+                             in2_buf->blue + (in2_buf + 1)->blue) >> 2;
+#endif
+        }
+
+        in1_buf += 2; /*Skip the next pixel because it is already used above*/
+        in2_buf += 2;
+        out_buf ++;
+    }
+}
+#endif
+
 #endif
@@ -23,15 +23,30 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#ifndef LV_VDB_DOUBLE
+#define LV_VDB_DOUBLE   0
+#endif
+
+#ifndef LV_VDB_OUT_BUF
+#define LV_VDB_OUT_BUF  0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef enum
+{
+    LV_VDB_STATE_FREE = 0,      /*Not used*/
+    LV_VDB_STATE_ACTIVE,        /*Being used to render*/
+    LV_VDB_STATE_FLUSH,         /*Flushing pixels from it*/
+}lv_vdb_state_t;
+
 typedef struct
 {
     area_t area;
-    color_t buf[LV_VDB_SIZE];
+    color_t * buf;              /*LV_VDB_SIZE pixels or the buffer of a layer (see 'lv_vdb_set_layer')*/
+    volatile uint8_t state;     /*State of the VDB from 'lv_vdb_state_t'*/
 }lv_vdb_t;
 
 
@@ -41,8 +56,9 @@ typedef struct
  **********************/
 
 /**
- * Get the vdb variable
- * @return pointer to the vdb variable
+ * Get the 'vdb' variable or allocate one in LV_VDB_DOUBLE mode
+ * (wait until a VDB becomes free if both are in use)
+ * @return pointer to a 'vdb' variable
  */
 lv_vdb_t * lv_vdb_get(void);
 
@@ -51,6 +67,26 @@ lv_vdb_t * lv_vdb_get(void);
  */
 void lv_vdb_flush(void);
 
+/**
+ * Wait until all the VDBs are flushed
+ */
+void lv_vdb_wait_flush(void);
+
+/**
+ * In 'LV_VDB_DOUBLE' or 'LV_VDB_OUT_BUF' mode has to be called when 'disp_map()'
+ * is ready with copying the map to a frame buffer.
+ * (Can be called from an interrupt or from an other thread)
+ */
+void lv_vdb_flush_ready(void);
+
+/**
+ * Redirect the drawing into an other buffer (e.g. to render an object into its layer).
+ * 'lv_vdb_get()' will return 'layer' until the previous one is set back.
+ * @param layer pointer to a VDB with the buffer and its area (NULL to draw into the VDB again)
+ * @return the previously set layer (or NULL). Set it back when the drawing is ready.
+ */
+lv_vdb_t * lv_vdb_set_layer(lv_vdb_t * layer);
+
 /**********************
  *      MACROS
  **********************/
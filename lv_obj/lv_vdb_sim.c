@@ -0,0 +1,141 @@
+/**
+ * @file lv_vdb_sim.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+#include "lv_vdb_sim.h"
+
+#if LV_VDB_SIZE != 0 && LV_VDB_SIM != 0
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include "lv_vdb.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * lv_vdb_sim_thread(void * param);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static void (*sim_map_cb)(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const color_t * color_p);
+static pthread_t sim_thread;
+static pthread_mutex_t sim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t sim_delay = LV_VDB_SIM_DELAY;
+static bool sim_pending;        /*A map is waiting to be copied*/
+static int32_t sim_x1;
+static int32_t sim_y1;
+static int32_t sim_x2;
+static int32_t sim_y2;
+static const color_t * sim_color_p;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start the thread of the simulated display driver
+ * @param map_cb called from the driver's thread to copy a map to the frame buffer
+ *               (like a DMA transfer). 'lv_vdb_flush_ready()' is called after it.
+ */
+void lv_vdb_sim_init(void (*map_cb)(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const color_t * color_p))
+{
+    sim_map_cb = map_cb;
+    sim_pending = false;
+    pthread_create(&sim_thread, NULL, lv_vdb_sim_thread, NULL);
+}
+
+/**
+ * Start a simulated flush and return immediately. Call it from 'disp_map()'.
+ * The map is copied with 'map_cb' after the delay on the driver's thread.
+ * @param x1 left coordinate of the map
+ * @param y1 top coordinate of the map
+ * @param x2 right coordinate of the map
+ * @param y2 bottom coordinate of the map
+ * @param color_p pointer to the pixels. Valid until 'lv_vdb_flush_ready()'.
+ */
+void lv_vdb_sim_map(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const color_t * color_p)
+{
+    pthread_mutex_lock(&sim_mutex);
+    /*'lv_vdb' starts a flush only if the previous is ready but wait anyway*/
+    while(sim_pending != false) pthread_cond_wait(&sim_cond, &sim_mutex);
+
+    sim_x1 = x1;
+    sim_y1 = y1;
+    sim_x2 = x2;
+    sim_y2 = y2;
+    sim_color_p = color_p;
+    sim_pending = true;
+    pthread_cond_broadcast(&sim_cond);
+    pthread_mutex_unlock(&sim_mutex);
+}
+
+/**
+ * Set the time of the simulated transfers
+ * @param delay_us delay before a map is copied in microseconds
+ */
+void lv_vdb_sim_set_delay(uint32_t delay_us)
+{
+    pthread_mutex_lock(&sim_mutex);
+    sim_delay = delay_us;
+    pthread_mutex_unlock(&sim_mutex);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * The function of the driver's thread. Copy the maps after the delay and release the VDB.
+ * @param param unused
+ * @return never returns
+ */
+static void * lv_vdb_sim_thread(void * param)
+{
+    (void) param;
+    struct timespec ts;
+
+    while(1) {
+        pthread_mutex_lock(&sim_mutex);
+        while(sim_pending == false) pthread_cond_wait(&sim_cond, &sim_mutex);
+        ts.tv_sec = sim_delay / 1000000;
+        ts.tv_nsec = (sim_delay % 1000000) * 1000;
+        pthread_mutex_unlock(&sim_mutex);
+
+        /*Simulate the transfer time*/
+        nanosleep(&ts, NULL);
+
+        if(sim_map_cb != NULL) sim_map_cb(sim_x1, sim_y1, sim_x2, sim_y2, sim_color_p);
+
+        pthread_mutex_lock(&sim_mutex);
+        sim_pending = false;
+        pthread_cond_broadcast(&sim_cond);
+        pthread_mutex_unlock(&sim_mutex);
+
+        lv_vdb_flush_ready();
+    }
+
+    return NULL;
+}
+
+#endif
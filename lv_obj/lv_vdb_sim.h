@@ -0,0 +1,78 @@
+/**
+ * @file lv_vdb_sim.h
+ * Simulated asynchronous display driver (POSIX threads) to try the
+ * LV_VDB_DOUBLE and LV_VDB_OUT_BUF modes without a real display
+ */
+
+#ifndef LV_VDB_SIM_H
+#define LV_VDB_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_conf.h"
+
+#ifndef LV_VDB_SIM
+#define LV_VDB_SIM          0
+#endif
+
+#ifndef LV_VDB_SIM_DELAY
+#define LV_VDB_SIM_DELAY    1000
+#endif
+
+#if LV_VDB_SIZE != 0 && LV_VDB_SIM != 0
+
+#include <stdint.h>
+#include "misc/gfx/color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start the thread of the simulated display driver
+ * @param map_cb called from the driver's thread to copy a map to the frame buffer
+ *               (like a DMA transfer). 'lv_vdb_flush_ready()' is called after it.
+ */
+void lv_vdb_sim_init(void (*map_cb)(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const color_t * color_p));
+
+/**
+ * Start a simulated flush and return immediately. Call it from 'disp_map()'.
+ * The map is copied with 'map_cb' after the delay on the driver's thread.
+ * @param x1 left coordinate of the map
+ * @param y1 top coordinate of the map
+ * @param x2 right coordinate of the map
+ * @param y2 bottom coordinate of the map
+ * @param color_p pointer to the pixels. Valid until 'lv_vdb_flush_ready()'.
+ */
+void lv_vdb_sim_map(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const color_t * color_p);
+
+/**
+ * Set the time of the simulated transfers
+ * @param delay_us delay before a map is copied in microseconds
+ */
+void lv_vdb_sim_set_delay(uint32_t delay_us);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_VDB_SIZE != 0 && LV_VDB_SIM != 0*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_VDB_SIM_H*/
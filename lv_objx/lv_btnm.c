@@ -139,7 +139,7 @@ bool lv_btnm_signal(lv_obj_t * btnm, lv_signal_t sign, void * param)
                     btn_area.y1 += btnm_area.y1;
                     btn_area.x2 += btnm_area.x1;
                     btn_area.y2 += btnm_area.y1;
-                    lv_inv_area(&btn_area);
+                    lv_obj_inv_area(btnm, &btn_area);
                 }
                 if(btn_pr != LV_BTNM_PR_NONE) {
                     area_cpy(&btn_area, &ext->btn_areas[btn_pr]);
@@ -147,7 +147,7 @@ bool lv_btnm_signal(lv_obj_t * btnm, lv_signal_t sign, void * param)
                     btn_area.y1 += btnm_area.y1;
                     btn_area.x2 += btnm_area.x1;
                     btn_area.y2 += btnm_area.y1;
-                    lv_inv_area(&btn_area);
+                    lv_obj_inv_area(btnm, &btn_area);
                 }
             }
 
@@ -177,7 +177,7 @@ bool lv_btnm_signal(lv_obj_t * btnm, lv_signal_t sign, void * param)
                 btn_area.y1 += btnm_area.y1;
                 btn_area.x2 += btnm_area.x1;
                 btn_area.y2 += btnm_area.y1;
-                lv_inv_area(&btn_area);
+                lv_obj_inv_area(btnm, &btn_area);
 
                 ext->btn_pr = LV_BTNM_PR_NONE;
             }
@@ -258,6 +258,9 @@ static void lv_cont_refr_layout(lv_obj_t * cont)
 
 	if(type == LV_CONT_LAYOUT_OFF) return;
 
+	/*Move the children in a batch to notify and invalidate them only once*/
+	lv_obj_batch_start();
+
 	if(type == LV_CONT_LAYOUT_CENTER) {
 		lv_cont_layout_center(cont);
 	} else if(type == LV_CONT_LAYOUT_COL_L || type == LV_CONT_LAYOUT_COL_M || type == LV_CONT_LAYOUT_COL_R) {
@@ -269,6 +272,8 @@ static void lv_cont_refr_layout(lv_obj_t * cont)
 	}  else if(type == LV_CONT_LAYOUT_GRID) {
 		lv_cont_layout_grid(cont);
 	}
+
+	lv_obj_batch_end();
 }
 
 /**
@@ -559,14 +564,12 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
 	}
 
 	area_t new_cords;
-	area_t ori;
 	lv_style_t * style = lv_obj_get_style(cont);
 	lv_obj_t * i;
 	cord_t hpad = style->hpad;
 	cord_t vpad = style->vpad;
 
 	/*Search the side coordinates of the children*/
-	lv_obj_get_cords(cont, &ori);
 	lv_obj_get_cords(cont, &new_cords);
 
 	new_cords.x1 = CORD_MAX;
@@ -605,16 +608,8 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
            cont->cords.x2 != new_cords.x2 ||
            cont->cords.y2 != new_cords.y2) {
 
-            lv_obj_inv(cont);
-            area_cpy(&cont->cords, &new_cords);
-            lv_obj_inv(cont);
-
-            /*Notify the object about its new coordinates*/
-            cont->signal_f(cont, LV_SIGNAL_CORD_CHG, &ori);
-
-            /*Inform the parent about the new coordinates*/
-            lv_obj_t * par = lv_obj_get_parent(cont);
-            par->signal_f(par, LV_SIGNAL_CHILD_CHG, cont);
+            /*Set the new coordinates and notify the object and its parent*/
+            lv_obj_set_cords(cont, &new_cords);
     	}
     }
 }
@@ -39,6 +39,7 @@
 
 #define LV_LABEL_DOT_NUM	3
 #define LV_LABEL_DOT_END_INV 0xFFFF
+#define LV_LABEL_LINE_ALLOC_STEP    8   /*Grow the line cache with this many lines*/
 
 /**********************
  *      TYPEDEFS
@@ -49,6 +50,7 @@
  **********************/
 static bool lv_label_design(lv_obj_t * label, const area_t * mask, lv_design_mode_t mode);
 static void lv_label_refr_text(lv_obj_t * label);
+static void lv_label_refr_lines(lv_obj_t * label);
 static void lv_label_set_offset_x(lv_obj_t * label, cord_t x);
 static void lv_label_set_offset_y(lv_obj_t * label, cord_t y);
 
@@ -87,6 +89,11 @@ lv_obj_t * lv_label_create(lv_obj_t * par, lv_obj_t * copy)
     ext->long_mode = LV_LABEL_LONG_EXPAND;
     ext->offset.x = 0;
     ext->offset.y = 0;
+    ext->lines = NULL;
+    ext->line_num = 0;
+    ext->line_cap = 0;
+    ext->lines_w = 0;
+    ext->lines_valid = 0;
 	lv_obj_set_design_f(new_label, lv_label_design);
 	lv_obj_set_signal_f(new_label, lv_label_signal);
 
@@ -136,10 +143,18 @@ bool lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param)
                     dm_free(ext->txt);
                     ext->txt = NULL;
                 }
+                if(ext->lines != NULL) {
+                    dm_free(ext->lines);
+                    ext->lines = NULL;
+                }
                 break;
             case LV_SIGNAL_STYLE_CHG:
             	lv_label_set_text(label, NULL);
             	break;
+            case LV_SIGNAL_CORD_CHG:
+                /*The lines has to be broken again with the new width*/
+                if(lv_obj_get_width(label) != ext->lines_w) ext->lines_valid = 0;
+                break;
 			default:
 				break;
     	}
@@ -355,35 +370,27 @@ void lv_label_get_letter_pos(lv_obj_t * label, uint16_t index, point_t * pos)
 {
 	const char * txt = lv_label_get_text(label);
     lv_label_ext_t * ext = lv_obj_get_ext(label);
-    uint32_t line_start = 0;
-    uint32_t new_line_start = 0;
-    cord_t max_w = lv_obj_get_width(label);
     lv_style_t * style = lv_obj_get_style(label);
     const font_t * font = style->font;
     uint8_t letter_height = font_get_height(font) >> FONT_ANTIALIAS;
-    cord_t y = 0;
     txt_flag_t flag = TXT_FLAG_NONE;
 
     if(ext->recolor != 0) flag |= TXT_FLAG_RECOLOR;
-    if(ext->expand != 0) flag |= TXT_FLAG_EXPAND;
 
-    /*If the width will be expanded  the set the max length to very big */
-    if(ext->long_mode == LV_LABEL_LONG_EXPAND || ext->long_mode == LV_LABEL_LONG_SCROLL) {
-        max_w = CORD_MAX;
-    }
+    lv_label_refr_lines(label);
 
     /*Search the line of the index letter */;
-    while (txt[new_line_start] != '\0') {
-        new_line_start += txt_get_next_line(&txt[line_start], font, style->letter_space, max_w, flag);
-        if(index < new_line_start || txt[new_line_start] == '\0') break; /*The line of 'index' letter begins at 'line_start'*/
+    uint16_t line = 0;
+    while(line + 1 < ext->line_num && index >= ext->lines[line + 1].start) line++;
 
-        y += letter_height + style->line_space;
-        line_start = new_line_start;
-    }
+    uint32_t line_start = ext->lines[line].start;
+    cord_t line_w = line < ext->line_num ? ext->lines[line].w : 0;
+    cord_t y = line * (letter_height + style->line_space);
 
-    if((txt[index - 1] == '\n' || txt[index - 1] == '\r') && txt[index] == '\0') {
+    if(index > 0 && (txt[index - 1] == '\n' || txt[index - 1] == '\r') && txt[index] == '\0') {
         y += letter_height + style->line_space;
         line_start = index;
+        line_w = 0;
     }
 
     /*Calculate the x coordinate*/
@@ -402,9 +409,6 @@ void lv_label_get_letter_pos(lv_obj_t * label, uint16_t index, point_t * pos)
 	}
 
 	if(style->txt_align == LV_TXT_ALIGN_MID) {
-		cord_t line_w;
-        line_w = txt_get_width(&txt[line_start], new_line_start - line_start,
-                               font, style->letter_space, flag);
 		x += lv_obj_get_width(label) / 2 - line_w / 2;
     }
 
@@ -423,9 +427,6 @@ uint16_t lv_label_get_letter_on(lv_obj_t * label, point_t * pos)
 {
 	const char * txt = lv_label_get_text(label);
     lv_label_ext_t * ext = lv_obj_get_ext(label);
-    uint32_t line_start = 0;
-    uint32_t new_line_start = 0;
-    cord_t max_w = lv_obj_get_width(label);
     lv_style_t * style = lv_obj_get_style(label);
     const font_t * font = style->font;
     uint8_t letter_height = font_get_height(font) >> FONT_ANTIALIAS;
@@ -433,33 +434,34 @@ uint16_t lv_label_get_letter_on(lv_obj_t * label, point_t * pos)
     txt_flag_t flag = TXT_FLAG_NONE;
 
     if(ext->recolor != 0) flag |= TXT_FLAG_RECOLOR;
-    if(ext->expand != 0) flag |= TXT_FLAG_EXPAND;
 
-    /*If the width will be expanded set the max length to very big */
-    if(ext->long_mode == LV_LABEL_LONG_EXPAND || ext->long_mode == LV_LABEL_LONG_SCROLL) {
-        max_w = CORD_MAX;
-    }
+    lv_label_refr_lines(label);
 
     /*Search the line of the index letter */;
-    while (txt[line_start] != '\0') {
-    	new_line_start += txt_get_next_line(&txt[line_start], font, style->letter_space, max_w, flag);
-    	if(pos->y <= y + letter_height + style->line_space) break; /*The line is found ('line_start')*/
+    uint16_t line = 0;
+    while(line < ext->line_num) {
+    	if(pos->y <= y + letter_height + style->line_space) break; /*The line is found*/
     	y += letter_height + style->line_space;
-        line_start = new_line_start;
+    	line++;
+    }
+
+    uint32_t line_start = ext->lines[line].start;
+    uint32_t line_end = line_start;
+    cord_t line_w = 0;
+    if(line < ext->line_num) {
+        line_end = ext->lines[line + 1].start;
+        line_w = ext->lines[line].w;
     }
 
     /*Calculate the x coordinate*/
     cord_t x = 0;
 	if(style->txt_align == LV_TXT_ALIGN_MID) {
-		cord_t line_w;
-        line_w = txt_get_width(&txt[line_start], new_line_start - line_start,
-                               font, style->letter_space, flag);
 		x += lv_obj_get_width(label) / 2 - line_w / 2;
     }
 
 	txt_cmd_state_t cmd_state = TXT_CMD_STATE_WAIT;
 	uint16_t i;
-	for(i = line_start; i < new_line_start - 1; i++) {
+	for(i = line_start; i + 1 < line_end; i++) {
 	    /*Handle the recolor command*/
 	    if((flag & TXT_FLAG_RECOLOR) != 0) {
             if(txt_is_cmd(&cmd_state, txt[i]) != false) {
@@ -512,7 +514,9 @@ static bool lv_label_design(lv_obj_t * label, const area_t * mask, lv_design_mod
             i++;
         }
 
-		lv_draw_label(&cords, mask, lv_obj_get_style(label), ext->txt, flag, &ext->offset);
+		lv_label_refr_lines(label);
+		lv_draw_label_lines(&cords, mask, lv_obj_get_style(label), ext->txt, flag, &ext->offset,
+		                    ext->lines, ext->line_num);
 
 
     }
@@ -527,6 +531,8 @@ static void lv_label_refr_text(lv_obj_t * label)
 {
     lv_label_ext_t * ext = lv_obj_get_ext(label);
 
+    ext->lines_valid = 0;   /*The text or the style has changed*/
+
     if(ext->txt == NULL) return;
 
     cord_t max_w = lv_obj_get_width(label);
@@ -670,12 +676,68 @@ static void lv_label_refr_text(lv_obj_t * label)
             }
             /*Save the dot end index*/
             ext->dot_end = index;
+            ext->lines_valid = 0;
         }
     }
 
     lv_obj_inv(label);
 }
 
+/**
+ * Break the text of the label into lines and save the line starts and widths
+ * if they are not up to date with the text, the style and the width.
+ * @param label pointer to a label object
+ */
+static void lv_label_refr_lines(lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext(label);
+
+    if(ext->lines_valid != 0) return;
+
+    const char * txt = ext->txt;
+    lv_style_t * style = lv_obj_get_style(label);
+    const font_t * font = style->font;
+    cord_t max_w = lv_obj_get_width(label);
+    txt_flag_t flag = TXT_FLAG_NONE;
+
+    if(ext->recolor != 0) flag |= TXT_FLAG_RECOLOR;
+    if(ext->expand != 0) flag |= TXT_FLAG_EXPAND;
+
+    /*If the width will be expanded set the max length to very big */
+    if(ext->long_mode == LV_LABEL_LONG_EXPAND ||
+       ext->long_mode == LV_LABEL_LONG_SCROLL ||
+       ext->expand != 0) {
+        max_w = CORD_MAX;
+    }
+
+    uint16_t line_num = 0;
+    uint32_t line_start = 0;
+    uint32_t line_end;
+    while(1) {
+        /*Allocate space for the line and the end position*/
+        if(line_num + 1 >= ext->line_cap) {
+            ext->line_cap += LV_LABEL_LINE_ALLOC_STEP;
+            ext->lines = dm_realloc(ext->lines, ext->line_cap * sizeof(lv_draw_label_line_t));
+            dm_assert(ext->lines);
+        }
+
+        ext->lines[line_num].start = line_start;
+        if(txt == NULL || txt[line_start] == '\0') break;
+
+        line_end = line_start + txt_get_next_line(&txt[line_start], font, style->letter_space, max_w, flag);
+        if(line_end == line_start) break;
+
+        ext->lines[line_num].w = txt_get_width(&txt[line_start], line_end - line_start,
+                                               font, style->letter_space, flag);
+        line_num++;
+        line_start = line_end;
+    }
+
+    ext->line_num = line_num;
+    ext->lines_w = lv_obj_get_width(label);
+    ext->lines_valid = 1;
+}
+
 
 static void lv_label_set_offset_x(lv_obj_t * label, cord_t x)
 {
@@ -17,6 +17,7 @@ extern "C" {
 #if USE_LV_LABEL != 0
 
 #include "../lv_obj/lv_obj.h"
+#include "../lv_draw/lv_draw.h"
 #include "misc/gfx/font.h"
 #include "misc/gfx/text.h"
 
@@ -49,9 +50,14 @@ typedef struct
     char dot_tmp[LV_LABEL_DOT_NUM + 1]; /*Store the character which are replaced by dots (Handled by the library)*/
     uint16_t dot_end;               /*The text end position in dot mode (Handled by the library)*/
     point_t offset;
+    lv_draw_label_line_t * lines;   /*Cached line breaks and line widths (Handled by the library)*/
+    uint16_t line_num;              /*Number of cached lines*/
+    uint16_t line_cap;              /*Number of allocated elements in 'lines'*/
+    cord_t lines_w;                 /*The object width when the lines were calculated*/
     uint8_t static_txt  :1;         /*Flag to indicate the text is static*/
     uint8_t recolor  :1;            /*Enable in-line letter re-coloring*/
     uint8_t expand  :1;             /*Force expand size when solving line length (used by the library with LV_LABEL_LONG_ROLL)*/
+    uint8_t lines_valid :1;         /*1: 'lines' are up to date with the text, style and width*/
 }lv_label_ext_t;
 
 /**********************
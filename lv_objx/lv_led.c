@@ -195,6 +195,7 @@ static bool lv_led_design(lv_obj_t * led, const area_t * mask, lv_design_mode_t
 		/*Make darker colors in a temporary style according to the brightness*/
 		lv_led_ext_t * ext = lv_obj_get_ext(led);
 		lv_style_t * style = lv_obj_get_style(led);
+		lv_style_t * style_ori_p = led->style_p;
 
 		/*Create a temporal style*/
         lv_style_t leds_tmp;
@@ -211,7 +212,7 @@ static bool lv_led_design(lv_obj_t * led, const area_t * mask, lv_design_mode_t
 
 		led->style_p = &leds_tmp;
 		ancestor_design_f(led, mask, mode);
-        led->style_p = style;
+        led->style_p = style_ori_p;     /*Restore the original (maybe NULL) style pointer*/
     }
     return true;
 }
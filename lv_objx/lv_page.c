@@ -82,6 +82,9 @@ lv_obj_t * lv_page_create(lv_obj_t * par, lv_obj_t * copy)
 		lv_obj_set_drag(ext->scrl, true);
 		lv_obj_set_drag_throw(ext->scrl, true);
 		lv_obj_set_protect(ext->scrl, LV_PROTECT_PARENT);
+#if LV_OBJ_MOVE_COPY != 0
+		lv_obj_set_move_copy(ext->scrl, true);
+#endif
 		lv_cont_set_fit(ext->scrl, true, true);
 		lv_obj_set_style(ext->scrl, lv_style_get(LV_STYLE_PRETTY, NULL));
 
@@ -298,7 +301,7 @@ static bool lv_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void* param)
 				        sb_area_tmp.y1 += page->cords.y1;
 				        sb_area_tmp.x2 += page->cords.x2;
 				        sb_area_tmp.y2 += page->cords.y2;
-				        lv_inv_area(&sb_area_tmp);
+				        lv_obj_inv_area(page, &sb_area_tmp);
 	                    page_ext->sbh_draw = 0;
 				    }
 				    if(page_ext->sbv_draw != 0)  {
@@ -307,7 +310,7 @@ static bool lv_scrl_signal(lv_obj_t * scrl, lv_signal_t sign, void* param)
 				        sb_area_tmp.y1 += page->cords.y1;
 				        sb_area_tmp.x2 += page->cords.x2;
 				        sb_area_tmp.y2 += page->cords.y2;
-				        lv_inv_area(&sb_area_tmp);
+				        lv_obj_inv_area(page, &sb_area_tmp);
 	                    page_ext->sbv_draw = 0;
 				    }
             	}
@@ -609,7 +612,7 @@ static void lv_page_sb_refresh(lv_obj_t * page)
         sb_area_tmp.y1 += page->cords.y1;
         sb_area_tmp.x2 += page->cords.x2;
         sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
+        lv_obj_inv_area(page, &sb_area_tmp);
     }
     if(ext->sbv_draw != 0)  {
         area_cpy(&sb_area_tmp, &ext->sbv);
@@ -617,7 +620,7 @@ static void lv_page_sb_refresh(lv_obj_t * page)
         sb_area_tmp.y1 += page->cords.y1;
         sb_area_tmp.x2 += page->cords.x2;
         sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
+        lv_obj_inv_area(page, &sb_area_tmp);
     }
 
     /*Horizontal scrollbar*/
@@ -660,7 +663,7 @@ static void lv_page_sb_refresh(lv_obj_t * page)
         sb_area_tmp.y1 += page->cords.y1;
         sb_area_tmp.x2 += page->cords.x2;
         sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
+        lv_obj_inv_area(page, &sb_area_tmp);
     }
     if(ext->sbv_draw != 0)  {
         area_cpy(&sb_area_tmp, &ext->sbv);
@@ -668,7 +671,7 @@ static void lv_page_sb_refresh(lv_obj_t * page)
         sb_area_tmp.y1 += page->cords.y1;
         sb_area_tmp.x2 += page->cords.x2;
         sb_area_tmp.y2 += page->cords.y2;
-        lv_inv_area(&sb_area_tmp);
+        lv_obj_inv_area(page, &sb_area_tmp);
     }
 }
 
@@ -17,6 +17,16 @@ extern "C" {
 /*Test misc. module version*/
 #include "misc/misc.h"
 #include "lv_obj/lv_obj.h"
+#include "lv_obj/lv_prof.h"
+#include "lv_obj/lv_bench.h"
+#include "lv_obj/lv_vdb_sim.h"
+#include "lv_draw/lv_gcache.h"
+#include "lv_draw/lv_scache.h"
+#include "lv_draw/lv_ccache.h"
+#include "lv_draw/lv_grad.h"
+#include "lv_draw/lv_dlist.h"
+#include "lv_obj/lv_mpool.h"
+#include "lv_obj/lv_tpool.h"
 #include "lv_objx/lv_btn.h"
 #include "lv_objx/lv_img.h"
 #include "lv_objx/lv_label.h"